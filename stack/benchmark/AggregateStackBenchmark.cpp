@@ -0,0 +1,81 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+
+#include "stack/AggregateStack.h"
+#include "stack/AggregateStack_impl.h"
+#include "stack/Stack.h"
+#include "stack/Stack_impl.h"
+
+#include "PerfCounters.h"
+
+static const size_t kQueriesCnt = 1000;
+
+static size_t value(size_t i) {
+  return (i * 2654435761U) % 1000003;
+}
+
+static size_t rescan_min(const Stack<size_t>& stack) {
+  Stack<size_t> copy{stack};
+  size_t min = copy.top();
+  while (!copy.empty()) {
+    min = std::min(min, copy.top());
+    copy.pop();
+  }
+  return min;
+}
+
+static void StackRescanMin(benchmark::State& state) {
+  Stack<size_t> stack;
+  for (size_t i = 0; i < static_cast<size_t>(state.range()); ++i) {
+    stack.push(value(i));
+  }
+
+  PerfCounters perf_counters{state};
+  for (auto _ : state) {
+    for (size_t i = 0; i < kQueriesCnt; ++i) {
+      stack.push(value(i));
+      benchmark::DoNotOptimize(rescan_min(stack));
+      stack.pop();
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kQueriesCnt);
+}
+
+static void AggregateStackMin(benchmark::State& state) {
+  AggregateStack<size_t, MinOp<size_t>> stack;
+  for (size_t i = 0; i < static_cast<size_t>(state.range()); ++i) {
+    stack.push(value(i));
+  }
+
+  PerfCounters perf_counters{state};
+  for (auto _ : state) {
+    for (size_t i = 0; i < kQueriesCnt; ++i) {
+      stack.push(value(i));
+      benchmark::DoNotOptimize(stack.aggregate());
+      stack.pop();
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kQueriesCnt);
+}
+
+static void AggregateQueueSlidingWindowMin(benchmark::State& state) {
+  AggregateQueue<size_t, MinOp<size_t>> queue;
+  for (size_t i = 0; i < static_cast<size_t>(state.range()); ++i) {
+    queue.push(value(i));
+  }
+
+  PerfCounters perf_counters{state};
+  for (auto _ : state) {
+    for (size_t i = 0; i < kQueriesCnt; ++i) {
+      queue.push(value(i));
+      queue.pop();
+      benchmark::DoNotOptimize(queue.aggregate());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kQueriesCnt);
+}
+
+BENCHMARK(StackRescanMin)->RangeMultiplier(8)->Range(8, 1 << 12);
+BENCHMARK(AggregateStackMin)->RangeMultiplier(8)->Range(8, 1 << 12);
+BENCHMARK(AggregateQueueSlidingWindowMin)->RangeMultiplier(8)->Range(8, 1 << 12);
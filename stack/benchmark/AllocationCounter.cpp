@@ -0,0 +1,60 @@
+#include "AllocationCounter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+static std::atomic<size_t> allocated_bytes{0};
+static std::atomic<size_t> peak_allocated_bytes{0};
+
+size_t AllocationCounter::allocated_bytes() {
+  return ::allocated_bytes.load(std::memory_order_relaxed);
+}
+
+size_t AllocationCounter::peak_bytes() {
+  return peak_allocated_bytes.load(std::memory_order_relaxed);
+}
+
+void AllocationCounter::reset_peak() {
+  peak_allocated_bytes.store(::allocated_bytes.load(std::memory_order_relaxed),
+                             std::memory_order_relaxed);
+}
+
+void* operator new(size_t size) {
+  void* ptr = std::malloc(size + sizeof(std::max_align_t));
+  if (ptr == nullptr) {
+    throw std::bad_alloc{};
+  }
+  *static_cast<size_t*>(ptr) = size;
+  size_t allocated = allocated_bytes.fetch_add(size, std::memory_order_relaxed) + size;
+  size_t peak = peak_allocated_bytes.load(std::memory_order_relaxed);
+  while (allocated > peak &&
+         !peak_allocated_bytes.compare_exchange_weak(peak, allocated, std::memory_order_relaxed)) {
+  }
+  return static_cast<char*>(ptr) + sizeof(std::max_align_t);
+}
+
+void* operator new[](size_t size) {
+  return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept {
+  if (ptr == nullptr) {
+    return;
+  }
+  void* base = static_cast<char*>(ptr) - sizeof(std::max_align_t);
+  allocated_bytes.fetch_sub(*static_cast<size_t*>(base), std::memory_order_relaxed);
+  std::free(base);
+}
+
+void operator delete[](void* ptr) noexcept {
+  operator delete(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+  operator delete(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept {
+  operator delete(ptr);
+}
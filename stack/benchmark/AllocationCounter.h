@@ -0,0 +1,16 @@
+#ifndef STACK_BENCHMARK_ALLOCATION_COUNTER_H
+#define STACK_BENCHMARK_ALLOCATION_COUNTER_H
+
+#include <cstddef>
+
+class AllocationCounter {
+ public:
+  AllocationCounter() = delete;
+
+  static size_t allocated_bytes();
+  static size_t peak_bytes();
+
+  static void reset_peak();
+};
+
+#endif /* STACK_BENCHMARK_ALLOCATION_COUNTER_H */
@@ -0,0 +1,46 @@
+#include <benchmark/benchmark.h>
+
+#include <unordered_set>
+
+#include "stack/Stack.h"
+#include "stack/Stack_impl.h"
+
+#include "PerfCounters.h"
+
+static const size_t kStepsCnt = 1 << 12;
+
+template <typename StackTy>
+static void DeduplicateSearchStates(benchmark::State& state) {
+  StackTy base;
+  for (size_t i = 0; i < static_cast<size_t>(state.range()); ++i) {
+    base.push(i);
+  }
+
+  PerfCounters perf_counters{state};
+  for (auto _ : state) {
+    std::unordered_set<StackTy> visited;
+    StackTy current{base};
+    size_t seed = 1;
+    for (size_t step = 0; step < kStepsCnt; ++step) {
+      seed = seed * 6364136223846793005U + 1442695040888963407U;
+      if ((seed >> 62) == 0 && current.size() > base.size()) {
+        current.pop();
+      } else {
+        current.push((seed >> 60) & 3);
+      }
+      if (visited.find(current) == visited.end()) {
+        visited.insert(current);
+      }
+    }
+    benchmark::DoNotOptimize(visited.size());
+  }
+  state.SetItemsProcessed(state.iterations() * kStepsCnt);
+}
+
+BENCHMARK_TEMPLATE(DeduplicateSearchStates, Stack<size_t>)->RangeMultiplier(8)->Range(8, 1 << 12);
+BENCHMARK_TEMPLATE(DeduplicateSearchStates, Stack<size_t, false, true>)
+    ->RangeMultiplier(8)
+    ->Range(8, 1 << 12);
+BENCHMARK_TEMPLATE(DeduplicateSearchStates, Stack<size_t, true, true>)
+    ->RangeMultiplier(8)
+    ->Range(8, 1 << 12);
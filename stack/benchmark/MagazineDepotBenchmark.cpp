@@ -0,0 +1,130 @@
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+#include "stack/MagazineDepot.h"
+#include "stack/MagazineDepot_impl.h"
+#include "stack/Stack.h"
+#include "stack/Stack_impl.h"
+
+#include "PerfCounters.h"
+
+static const size_t kObjectsCnt = 1 << 16;
+static const size_t kBatchSize = 32;
+
+class LockedFreeList {
+ public:
+  LockedFreeList() {
+    for (size_t i = 0; i < kObjectsCnt; ++i) {
+      free_.push(i);
+    }
+  }
+
+  size_t pop() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t idx = free_.top();
+    free_.pop();
+    return idx;
+  }
+
+  void push(size_t idx) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    free_.push(idx);
+  }
+
+ private:
+  std::mutex mutex_;
+  Stack<size_t> free_;
+};
+
+class LockFreeFreeList {
+ public:
+  LockFreeFreeList() {
+    for (size_t i = 0; i < kObjectsCnt; ++i) {
+      next_[i].store(i, std::memory_order_relaxed);
+    }
+    head_.store(kObjectsCnt, std::memory_order_relaxed);
+  }
+
+  size_t pop() {
+    uint64_t head = head_.load(std::memory_order_acquire);
+    while (true) {
+      uint32_t idx = static_cast<uint32_t>(head) - 1;
+      uint64_t new_head = ((head >> 32) + 1) << 32 | next_[idx].load(std::memory_order_relaxed);
+      if (head_.compare_exchange_weak(head, new_head, std::memory_order_acquire)) {
+        return idx;
+      }
+    }
+  }
+
+  void push(size_t idx) {
+    uint64_t head = head_.load(std::memory_order_relaxed);
+    while (true) {
+      next_[idx].store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+      uint64_t new_head = ((head >> 32) + 1) << 32 | (idx + 1);
+      if (head_.compare_exchange_weak(head, new_head, std::memory_order_release)) {
+        return;
+      }
+    }
+  }
+
+ private:
+  std::atomic<uint64_t> head_;
+  std::atomic<uint32_t> next_[kObjectsCnt];
+};
+
+static MagazineDepot<size_t>& seeded_depot() {
+  static MagazineDepot<size_t> depot;
+  static bool seeded = [] {
+    MagazineCache<size_t> cache{depot};
+    for (size_t i = 0; i < kObjectsCnt; ++i) {
+      cache.push(i);
+    }
+    cache.flush();
+    return true;
+  }();
+  (void)seeded;
+  return depot;
+}
+
+template <typename FreeListTy>
+static void SharedFreeList(benchmark::State& state) {
+  static FreeListTy free_list;
+  size_t held[kBatchSize];
+
+  PerfCounters perf_counters{state};
+  for (auto _ : state) {
+    for (size_t& idx : held) {
+      idx = free_list.pop();
+    }
+    benchmark::DoNotOptimize(held);
+    for (size_t idx : held) {
+      free_list.push(idx);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kBatchSize * 2);
+}
+
+static void MagazineFreeList(benchmark::State& state) {
+  MagazineDepot<size_t>& depot = seeded_depot();
+  MagazineCache<size_t> cache{depot};
+  size_t held[kBatchSize];
+
+  PerfCounters perf_counters{state};
+  for (auto _ : state) {
+    for (size_t& idx : held) {
+      idx = *cache.pop();
+    }
+    benchmark::DoNotOptimize(held);
+    for (size_t idx : held) {
+      cache.push(idx);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kBatchSize * 2);
+}
+
+BENCHMARK_TEMPLATE(SharedFreeList, LockedFreeList)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK_TEMPLATE(SharedFreeList, LockFreeFreeList)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(MagazineFreeList)->ThreadRange(1, 8)->UseRealTime();
@@ -0,0 +1,93 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <thread>
+
+#include "stack/ParallelStack.h"
+#include "stack/ParallelStack_impl.h"
+#include "stack/Stack.h"
+#include "stack/Stack_impl.h"
+#include "stack/ThreadPool.h"
+#include "stack/ThreadPool_impl.h"
+
+#include "PerfCounters.h"
+
+static const size_t kStackSize = 1 << 23;
+
+static Stack<size_t> make_stack() {
+  Stack<size_t> stack;
+  for (size_t i = 0; i < kStackSize; ++i) {
+    stack.push(i);
+  }
+  return stack;
+}
+
+static void SerialCopy(benchmark::State& state) {
+  Stack<size_t> stack = make_stack();
+  PerfCounters perf_counters{state};
+  for (auto _ : state) {
+    Stack<size_t> copy{stack};
+    benchmark::DoNotOptimize(copy.data());
+  }
+  state.SetBytesProcessed(state.iterations() * kStackSize * sizeof(size_t));
+}
+
+static void ParallelCopy(benchmark::State& state) {
+  ThreadPool pool(state.range());
+  Stack<size_t> stack = make_stack();
+  PerfCounters perf_counters{state};
+  for (auto _ : state) {
+    Stack<size_t> copy = ParallelStack::copy(ParallelPolicy{&pool}, stack);
+    benchmark::DoNotOptimize(copy.data());
+  }
+  state.SetBytesProcessed(state.iterations() * kStackSize * sizeof(size_t));
+}
+
+static void SerialEquals(benchmark::State& state) {
+  Stack<size_t> x = make_stack();
+  Stack<size_t> y{x};
+  PerfCounters perf_counters{state};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(x == y);
+  }
+  state.SetBytesProcessed(state.iterations() * 2 * kStackSize * sizeof(size_t));
+}
+
+static void ParallelEquals(benchmark::State& state) {
+  ThreadPool pool(state.range());
+  Stack<size_t> x = make_stack();
+  Stack<size_t> y{x};
+  PerfCounters perf_counters{state};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(ParallelStack::equals(ParallelPolicy{&pool}, x, y));
+  }
+  state.SetBytesProcessed(state.iterations() * 2 * kStackSize * sizeof(size_t));
+}
+
+static void ParallelEqualsEarlyMismatch(benchmark::State& state) {
+  ThreadPool pool(state.range());
+  Stack<size_t> x = make_stack();
+  Stack<size_t> y{x};
+  y.data()[kStackSize / 8] = 0;
+  PerfCounters perf_counters{state};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(ParallelStack::equals(ParallelPolicy{&pool}, x, y));
+  }
+}
+
+static void ThreadCounts(benchmark::internal::Benchmark* benchmark) {
+  size_t max_threads = std::max(1U, std::thread::hardware_concurrency());
+  for (size_t threads = 1; threads < max_threads; threads *= 2) {
+    benchmark->Arg(threads);
+  }
+  benchmark->Arg(max_threads);
+}
+
+BENCHMARK(SerialCopy)->Unit(benchmark::kMillisecond);
+BENCHMARK(ParallelCopy)->Apply(ThreadCounts)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(SerialEquals)->Unit(benchmark::kMillisecond);
+BENCHMARK(ParallelEquals)->Apply(ThreadCounts)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(ParallelEqualsEarlyMismatch)
+    ->Apply(ThreadCounts)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
@@ -0,0 +1,90 @@
+#include "PerfCounters.h"
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cstring>
+
+static uint64_t cache_miss_config(uint64_t cache) {
+  return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+}
+
+static int open_event(uint32_t type, uint64_t config) {
+  perf_event_attr attr;
+  std::memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = type;
+  attr.config = config;
+  attr.disabled = 1;
+  attr.inherit = 1;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+  return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+}
+
+PerfCounters::PerfCounters(benchmark::State& state)
+    : state_(state),
+      events_{
+          {"cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, -1},
+          {"instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, -1},
+          {"L1d-misses", PERF_TYPE_HW_CACHE, cache_miss_config(PERF_COUNT_HW_CACHE_L1D), -1},
+          {"LLC-misses", PERF_TYPE_HW_CACHE, cache_miss_config(PERF_COUNT_HW_CACHE_LL), -1},
+          {"dTLB-misses", PERF_TYPE_HW_CACHE, cache_miss_config(PERF_COUNT_HW_CACHE_DTLB), -1},
+          {"page-faults", PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS, -1},
+      } {
+  for (Event& event : events_) {
+    event.fd_ = open_event(event.type_, event.config_);
+  }
+  for (const Event& event : events_) {
+    if (event.fd_ != -1) {
+      ioctl(event.fd_, PERF_EVENT_IOC_RESET, 0);
+      ioctl(event.fd_, PERF_EVENT_IOC_ENABLE, 0);
+    }
+  }
+}
+
+PerfCounters::~PerfCounters() {
+  for (const Event& event : events_) {
+    if (event.fd_ != -1) {
+      ioctl(event.fd_, PERF_EVENT_IOC_DISABLE, 0);
+    }
+  }
+
+  double values[kEventsCnt]{};
+  bool available[kEventsCnt]{};
+  for (size_t i = 0; i < kEventsCnt; ++i) {
+    available[i] = read_event(events_[i], values[i]);
+    if (available[i]) {
+      state_.counters[events_[i].name_] =
+          benchmark::Counter(values[i], benchmark::Counter::kAvgIterations);
+    }
+    if (events_[i].fd_ != -1) {
+      close(events_[i].fd_);
+    }
+  }
+
+  if (available[kCyclesIdx] && available[kInstructionsIdx] && values[kCyclesIdx] > 0) {
+    state_.counters["IPC"] = values[kInstructionsIdx] / values[kCyclesIdx];
+  }
+}
+
+bool PerfCounters::read_event(const Event& event, double& value) {
+  if (event.fd_ == -1) {
+    return false;
+  }
+
+  uint64_t counts[3];
+  if (read(event.fd_, counts, sizeof(counts)) != sizeof(counts) || counts[2] == 0) {
+    return false;
+  }
+
+  value = static_cast<double>(counts[0]);
+  if (counts[2] < counts[1]) {
+    value *= static_cast<double>(counts[1]) / static_cast<double>(counts[2]);
+  }
+  return true;
+}
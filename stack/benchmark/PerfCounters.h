@@ -0,0 +1,38 @@
+#ifndef STACK_BENCHMARK_PERF_COUNTERS_H
+#define STACK_BENCHMARK_PERF_COUNTERS_H
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+
+class PerfCounters {
+ public:
+  explicit PerfCounters(benchmark::State& state);
+  PerfCounters(const PerfCounters& other) = delete;
+  PerfCounters(PerfCounters&& other) = delete;
+
+  ~PerfCounters();
+
+  PerfCounters& operator=(const PerfCounters& rhs) = delete;
+  PerfCounters& operator=(PerfCounters&& other) = delete;
+
+ private:
+  struct Event {
+    const char* name_;
+    uint32_t type_;
+    uint64_t config_;
+    int fd_;
+  };
+
+  static const size_t kEventsCnt = 6;
+  static const size_t kCyclesIdx = 0;
+  static const size_t kInstructionsIdx = 1;
+
+  benchmark::State& state_;
+  Event events_[kEventsCnt];
+
+  static bool read_event(const Event& event, double& value);
+};
+
+#endif /* STACK_BENCHMARK_PERF_COUNTERS_H */
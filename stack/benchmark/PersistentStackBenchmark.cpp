@@ -0,0 +1,44 @@
+#include <benchmark/benchmark.h>
+
+#include "stack/PersistentStack.h"
+#include "stack/PersistentStack_impl.h"
+#include "stack/Stack.h"
+#include "stack/Stack_impl.h"
+
+#include "PerfCounters.h"
+
+static const size_t kBranchingFactor = 3;
+static const size_t kPrefixSize = 1000;
+
+template <typename StackTy>
+static void search(const StackTy& stack, size_t depth, size_t& leaves) {
+  if (depth == 0) {
+    leaves += stack.size();
+    return;
+  }
+
+  for (size_t i = 0; i < kBranchingFactor; ++i) {
+    StackTy snapshot{stack};
+    snapshot.push(i);
+    search(snapshot, depth - 1, leaves);
+  }
+}
+
+template <typename StackTy>
+static void BranchingSearch(benchmark::State& state) {
+  StackTy prefix;
+  for (size_t i = 0; i < kPrefixSize; ++i) {
+    prefix.push(i);
+  }
+
+  PerfCounters perf_counters{state};
+  for (auto _ : state) {
+    size_t leaves = 0;
+    search(prefix, state.range(), leaves);
+    benchmark::DoNotOptimize(leaves);
+  }
+}
+
+BENCHMARK_TEMPLATE(BranchingSearch, Stack<size_t>)->DenseRange(2, 8, 2);
+BENCHMARK_TEMPLATE(BranchingSearch, PersistentStack<size_t>)->DenseRange(2, 8, 2);
+BENCHMARK_TEMPLATE(BranchingSearch, PersistentStack<size_t, false>)->DenseRange(2, 8, 2);
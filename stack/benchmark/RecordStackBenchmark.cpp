@@ -0,0 +1,74 @@
+#include <benchmark/benchmark.h>
+
+#include <memory>
+
+#include "stack/RecordStack.h"
+#include "stack/RecordStack_impl.h"
+#include "stack/Stack.h"
+#include "stack/Stack_impl.h"
+
+#include "PerfCounters.h"
+
+static const size_t kCallDepth = 256;
+
+struct Frame {
+  virtual ~Frame() = default;
+
+  size_t return_address{0};
+};
+
+template <size_t LocalsCnt>
+struct SizedFrame : Frame {
+  size_t locals[LocalsCnt]{};
+};
+
+using SmallFrame = SizedFrame<2>;
+using LargeFrame = SizedFrame<14>;
+
+static void PointerStackFrames(benchmark::State& state) {
+  Stack<std::unique_ptr<Frame>> stack;
+  PerfCounters perf_counters{state};
+  for (auto _ : state) {
+    for (size_t depth = 0; depth < kCallDepth; ++depth) {
+      if (depth % 4 == 0) {
+        stack.push(std::make_unique<LargeFrame>());
+      } else {
+        stack.push(std::make_unique<SmallFrame>());
+      }
+      stack.top()->return_address = depth;
+    }
+    while (!stack.empty()) {
+      benchmark::DoNotOptimize(stack.top()->return_address);
+      stack.top().reset();
+      stack.pop();
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kCallDepth);
+}
+
+static void RecordStackFrames(benchmark::State& state) {
+  RecordStack stack;
+  PerfCounters perf_counters{state};
+  for (auto _ : state) {
+    for (size_t depth = 0; depth < kCallDepth; ++depth) {
+      if (depth % 4 == 0) {
+        stack.emplace<LargeFrame>().return_address = depth;
+      } else {
+        stack.emplace<SmallFrame>().return_address = depth;
+      }
+    }
+    for (size_t depth = kCallDepth; depth-- > 0;) {
+      if (depth % 4 == 0) {
+        benchmark::DoNotOptimize(stack.top<LargeFrame>().return_address);
+        stack.pop<LargeFrame>();
+      } else {
+        benchmark::DoNotOptimize(stack.top<SmallFrame>().return_address);
+        stack.pop<SmallFrame>();
+      }
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kCallDepth);
+}
+
+BENCHMARK(PointerStackFrames);
+BENCHMARK(RecordStackFrames);
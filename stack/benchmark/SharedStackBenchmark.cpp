@@ -0,0 +1,125 @@
+#include <benchmark/benchmark.h>
+
+#include <sched.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <string>
+
+#include "stack/SharedStack.h"
+#include "stack/SharedStack_impl.h"
+
+#include "PerfCounters.h"
+
+static const size_t kBatchSize = 1024;
+static const size_t kStop = static_cast<size_t>(-1);
+
+static bool read_full(int fd, void* buffer, size_t bytes) {
+  auto* dst = static_cast<char*>(buffer);
+  while (bytes > 0) {
+    ssize_t res = read(fd, dst, bytes);
+    if (res <= 0) {
+      return false;
+    }
+    dst += res;
+    bytes -= res;
+  }
+  return true;
+}
+
+static void consume_shared_stack(const std::string& items_name, const std::string& acks_name) {
+  SharedStack<size_t> items{items_name};
+  SharedStack<size_t> acks{acks_name};
+  size_t received = 0;
+  while (true) {
+    std::optional<size_t> item = items.pop();
+    if (!item.has_value()) {
+      sched_yield();
+      continue;
+    }
+    if (*item == kStop) {
+      return;
+    }
+    if (++received == kBatchSize) {
+      acks.push(received);
+      received = 0;
+    }
+  }
+}
+
+static void consume_socket(int fd) {
+  size_t received = 0;
+  size_t item = 0;
+  while (read_full(fd, &item, sizeof(item))) {
+    if (++received == kBatchSize) {
+      char ack = 0;
+      if (write(fd, &ack, sizeof(ack)) != sizeof(ack)) {
+        return;
+      }
+      received = 0;
+    }
+  }
+}
+
+static void SharedStackTransfer(benchmark::State& state) {
+  std::string name = "/shared-stack-benchmark-" + std::to_string(getpid());
+  SharedStack<size_t> items{name + "-items", kBatchSize};
+  SharedStack<size_t> acks{name + "-acks", 1};
+
+  pid_t pid = fork();
+  if (pid == 0) {
+    consume_shared_stack(items.name(), acks.name());
+    _exit(0);
+  }
+
+  PerfCounters perf_counters{state};
+  for (auto _ : state) {
+    for (size_t i = 0; i < kBatchSize; ++i) {
+      items.push(i);
+    }
+    while (!acks.pop().has_value()) {
+      sched_yield();
+    }
+  }
+  items.push(kStop);
+  waitpid(pid, nullptr, 0);
+  state.SetItemsProcessed(state.iterations() * kBatchSize);
+}
+
+static void SocketTransfer(benchmark::State& state) {
+  int fds[2];
+  if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == -1) {
+    state.SkipWithError("socketpair failed");
+    return;
+  }
+
+  pid_t pid = fork();
+  if (pid == 0) {
+    close(fds[0]);
+    consume_socket(fds[1]);
+    _exit(0);
+  }
+  close(fds[1]);
+
+  PerfCounters perf_counters{state};
+  for (auto _ : state) {
+    for (size_t i = 0; i < kBatchSize; ++i) {
+      if (write(fds[0], &i, sizeof(i)) != sizeof(i)) {
+        state.SkipWithError("write failed");
+        break;
+      }
+    }
+    char ack = 0;
+    if (!read_full(fds[0], &ack, sizeof(ack))) {
+      state.SkipWithError("read failed");
+      break;
+    }
+  }
+  close(fds[0]);
+  waitpid(pid, nullptr, 0);
+  state.SetItemsProcessed(state.iterations() * kBatchSize);
+}
+
+BENCHMARK(SharedStackTransfer)->UseRealTime();
+BENCHMARK(SocketTransfer)->UseRealTime();
@@ -0,0 +1,46 @@
+#include <benchmark/benchmark.h>
+
+#include "stack/SpillingStack.h"
+#include "stack/SpillingStack_impl.h"
+#include "stack/Stack.h"
+#include "stack/Stack_impl.h"
+
+#include "PerfCounters.h"
+
+static const size_t kStackPushesCnt = 1 << 23;
+static const size_t kMemoryBudget = 1 << 20;
+
+template <typename StackTy>
+static void fill_and_drain(StackTy& stack) {
+  for (size_t i = 0; i < kStackPushesCnt; ++i) {
+    stack.push(i);
+  }
+  while (!stack.empty()) {
+    benchmark::DoNotOptimize(stack.top());
+    stack.pop();
+  }
+}
+
+static void InMemoryStack(benchmark::State& state) {
+  PerfCounters perf_counters{state};
+  for (auto _ : state) {
+    Stack<size_t> stack;
+    fill_and_drain(stack);
+  }
+  state.SetBytesProcessed(state.iterations() * kStackPushesCnt * sizeof(size_t));
+}
+
+static void SpillingStackTinyBudget(benchmark::State& state) {
+  PerfCounters perf_counters{state};
+  for (auto _ : state) {
+    SpillingStack<size_t> stack(kMemoryBudget, state.range());
+    fill_and_drain(stack);
+  }
+  state.SetBytesProcessed(state.iterations() * kStackPushesCnt * sizeof(size_t));
+}
+
+BENCHMARK(InMemoryStack)->Unit(benchmark::kMillisecond);
+BENCHMARK(SpillingStackTinyBudget)
+    ->RangeMultiplier(4)
+    ->Range(1 << 10, 1 << 14)
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,67 @@
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <vector>
+
+#include "stack/Stack.h"
+#include "stack/Stack_impl.h"
+#include "stack/StackArena.h"
+#include "stack/StackArena_impl.h"
+
+#include "AllocationCounter.h"
+#include "PerfCounters.h"
+
+static const size_t kOpsPerStack = 16;
+
+static size_t stack_idx(size_t op, size_t stacks_cnt) {
+  return (op * 2654435761U) % stacks_cnt;
+}
+
+static void VectorOfStacks(benchmark::State& state) {
+  size_t stacks_cnt = state.range();
+  size_t peak_bytes = 0;
+  PerfCounters perf_counters{state};
+  for (auto _ : state) {
+    size_t base_bytes = AllocationCounter::allocated_bytes();
+    AllocationCounter::reset_peak();
+    std::vector<Stack<size_t>> stacks(stacks_cnt);
+    for (size_t op = 0; op < kOpsPerStack * stacks_cnt; ++op) {
+      Stack<size_t>& stack = stacks[stack_idx(op, stacks_cnt)];
+      if (op % 4 == 3 && !stack.empty()) {
+        stack.pop();
+      } else {
+        stack.push(op);
+      }
+    }
+    peak_bytes = AllocationCounter::peak_bytes() - base_bytes;
+    benchmark::DoNotOptimize(stacks.data());
+  }
+  state.counters["peak_bytes"] = peak_bytes;
+  state.SetItemsProcessed(state.iterations() * kOpsPerStack * stacks_cnt);
+}
+
+static void Arena(benchmark::State& state) {
+  size_t stacks_cnt = state.range();
+  size_t peak_bytes = 0;
+  PerfCounters perf_counters{state};
+  for (auto _ : state) {
+    size_t base_bytes = AllocationCounter::allocated_bytes();
+    AllocationCounter::reset_peak();
+    StackArena<size_t> arena(stacks_cnt);
+    for (size_t op = 0; op < kOpsPerStack * stacks_cnt; ++op) {
+      auto stack = arena.stack(stack_idx(op, stacks_cnt));
+      if (op % 4 == 3 && !stack.empty()) {
+        stack.pop();
+      } else {
+        stack.push(op);
+      }
+    }
+    peak_bytes = AllocationCounter::peak_bytes() - base_bytes;
+    benchmark::DoNotOptimize(&arena);
+  }
+  state.counters["peak_bytes"] = peak_bytes;
+  state.SetItemsProcessed(state.iterations() * kOpsPerStack * stacks_cnt);
+}
+
+BENCHMARK(VectorOfStacks)->RangeMultiplier(10)->Range(10, 100000);
+BENCHMARK(Arena)->RangeMultiplier(10)->Range(10, 100000);
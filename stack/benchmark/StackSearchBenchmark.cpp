@@ -0,0 +1,101 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <optional>
+
+#include "stack/Stack.h"
+#include "stack/Stack_impl.h"
+
+#include "PerfCounters.h"
+
+template <typename ElemTy>
+static Stack<ElemTy> make_stack(size_t size) {
+  Stack<ElemTy> stack;
+  stack.push(static_cast<ElemTy>(-1));
+  for (size_t i = 1; i < size; ++i) {
+    stack.push(static_cast<ElemTy>(i % 100));
+  }
+  return stack;
+}
+
+template <typename ElemTy>
+static void CopyAndPopDepth(benchmark::State& state) {
+  Stack<ElemTy> stack = make_stack<ElemTy>(state.range());
+  PerfCounters perf_counters{state};
+  for (auto _ : state) {
+    Stack<ElemTy> copy{stack};
+    size_t depth = 0;
+    while (!copy.empty() && copy.top() != static_cast<ElemTy>(-1)) {
+      copy.pop();
+      ++depth;
+    }
+    benchmark::DoNotOptimize(depth);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range());
+}
+
+template <typename ElemTy>
+static void ScalarDepth(benchmark::State& state) {
+  Stack<ElemTy> stack = make_stack<ElemTy>(state.range());
+  PerfCounters perf_counters{state};
+  for (auto _ : state) {
+    auto it = std::find(stack.rbegin(), stack.rend(), static_cast<ElemTy>(-1));
+    benchmark::DoNotOptimize(it);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range());
+}
+
+template <typename ElemTy>
+static void SimdDepth(benchmark::State& state) {
+  Stack<ElemTy> stack = make_stack<ElemTy>(state.range());
+  PerfCounters perf_counters{state};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(stack.depth_of(static_cast<ElemTy>(-1)));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range());
+}
+
+template <typename ElemTy>
+static void SimdCount(benchmark::State& state) {
+  Stack<ElemTy> stack = make_stack<ElemTy>(state.range());
+  PerfCounters perf_counters{state};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(stack.count(static_cast<ElemTy>(42)));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range());
+}
+
+static void BoolIteratorCount(benchmark::State& state) {
+  Stack<bool> stack;
+  for (size_t i = 0; i < static_cast<size_t>(state.range()); ++i) {
+    stack.push(i % 3 == 0);
+  }
+  PerfCounters perf_counters{state};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(std::count(stack.begin(), stack.end(), true));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range());
+}
+
+static void BoolWordCount(benchmark::State& state) {
+  Stack<bool> stack;
+  for (size_t i = 0; i < static_cast<size_t>(state.range()); ++i) {
+    stack.push(i % 3 == 0);
+  }
+  PerfCounters perf_counters{state};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(stack.count(true));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range());
+}
+
+BENCHMARK_TEMPLATE(CopyAndPopDepth, int)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(ScalarDepth, int)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(SimdDepth, int)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(SimdCount, int)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(ScalarDepth, double)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(SimdDepth, double)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(ScalarDepth, char)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(SimdDepth, char)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(BoolIteratorCount)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(BoolWordCount)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
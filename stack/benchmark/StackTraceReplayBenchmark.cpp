@@ -0,0 +1,386 @@
+#include <benchmark/benchmark.h>
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "stack/PersistentStack.h"
+#include "stack/PersistentStack_impl.h"
+#include "stack/Stack.h"
+#include "stack/StackArena.h"
+#include "stack/StackArena_impl.h"
+#include "stack/StackTracer.h"
+#include "stack/StackTracer_impl.h"
+#include "stack/Stack_impl.h"
+
+#include "AllocationCounter.h"
+#include "PerfCounters.h"
+
+using Op = StackTracer::Op;
+
+static const float kGrowCoeffs[] = {1.1, 1.25, 1.5, 2, 3};
+
+static const size_t kSyntheticStacksCnt = 256;
+static const size_t kSyntheticOpsCnt = 1 << 20;
+static const size_t kSyntheticElemSize = 16;
+static const size_t kSyntheticRecreatePeriod = 1 << 12;
+
+template <size_t Size>
+struct Blob {
+  std::array<unsigned char, Size> bytes_;
+};
+
+struct ReplayOp {
+  uint32_t slot_;
+  uint32_t arg_;
+  Op op_;
+};
+
+struct Replay {
+  std::vector<ReplayOp> ops_;
+  size_t slots_cnt_{0};
+  size_t elem_size_{0};
+  size_t skipped_cnt_{0};
+};
+
+static Replay compile(const std::vector<StackTracer::Record>& records) {
+  Replay replay;
+  std::unordered_map<uint64_t, uint32_t> slots;
+  std::vector<uint32_t> free_slots;
+
+  auto open_slot = [&](uint64_t stack, uint32_t size) {
+    uint32_t slot = 0;
+    if (free_slots.empty()) {
+      slot = replay.slots_cnt_++;
+    } else {
+      slot = free_slots.back();
+      free_slots.pop_back();
+    }
+    slots[stack] = slot;
+    replay.ops_.push_back(ReplayOp{slot, size, Op::kCreate});
+    return slot;
+  };
+
+  for (const StackTracer::Record& record : records) {
+    if (record.elem_size_ == 0) {
+      ++replay.skipped_cnt_;
+      continue;
+    }
+    replay.elem_size_ = std::max<size_t>(replay.elem_size_, record.elem_size_);
+    auto it = slots.find(record.stack_);
+    switch (record.op_) {
+      case Op::kCreate:
+        if (it == slots.end()) {
+          open_slot(record.stack_, record.arg_);
+        } else {
+          replay.ops_.push_back(ReplayOp{it->second, record.arg_, Op::kCreate});
+        }
+        break;
+      case Op::kDestroy:
+        if (it != slots.end()) {
+          replay.ops_.push_back(ReplayOp{it->second, 0, Op::kDestroy});
+          free_slots.push_back(it->second);
+          slots.erase(it);
+        }
+        break;
+      case Op::kPush: {
+        uint32_t slot = it == slots.end() ? open_slot(record.stack_, record.arg_ - 1) : it->second;
+        replay.ops_.push_back(ReplayOp{slot, 0, Op::kPush});
+        break;
+      }
+      case Op::kPop: {
+        uint32_t slot = it == slots.end() ? open_slot(record.stack_, record.arg_ + 1) : it->second;
+        replay.ops_.push_back(ReplayOp{slot, 0, Op::kPop});
+        break;
+      }
+      case Op::kMovedFrom:
+        if (it != slots.end()) {
+          replay.ops_.push_back(ReplayOp{it->second, 0, Op::kCreate});
+        }
+        break;
+      case Op::kGrow:
+        break;
+    }
+  }
+  return replay;
+}
+
+static std::string record_synthetic_trace() {
+  std::string path = "/tmp/stack-trace-replay-" + std::to_string(getpid()) + ".trace";
+  std::vector<size_t> sizes(kSyntheticStacksCnt);
+
+  StackTracer& tracer = StackTracer::instance();
+  tracer.start(path);
+  for (size_t& size : sizes) {
+    tracer.record(&size, Op::kCreate, kSyntheticElemSize, 0);
+  }
+  for (size_t op = 0; op < kSyntheticOpsCnt; ++op) {
+    size_t hash = op * 2654435761U;
+    size_t& size = sizes[hash % (1 + (hash >> 16) % kSyntheticStacksCnt)];
+    if (op % kSyntheticRecreatePeriod == 0) {
+      tracer.record(&size, Op::kDestroy, kSyntheticElemSize, 0);
+      size = 0;
+      tracer.record(&size, Op::kCreate, kSyntheticElemSize, 0);
+    } else if (size > 0 && hash % 16 < 7) {
+      tracer.record(&size, Op::kPop, kSyntheticElemSize, --size);
+    } else {
+      tracer.record(&size, Op::kPush, kSyntheticElemSize, ++size);
+    }
+  }
+  for (size_t& size : sizes) {
+    tracer.record(&size, Op::kDestroy, kSyntheticElemSize, 0);
+  }
+  tracer.stop();
+  return path;
+}
+
+template <typename ElemTy>
+class StackSlots {
+ public:
+  StackSlots(size_t slots_cnt, float grow_coeff) : slots_(slots_cnt), grow_coeff_(grow_coeff) {}
+
+  void create(size_t slot, size_t size) {
+    slots_[slot].emplace(grow_coeff_);
+    for (size_t i = 0; i < size; ++i) {
+      slots_[slot]->push(ElemTy{});
+    }
+  }
+
+  void destroy(size_t slot) {
+    slots_[slot].reset();
+  }
+
+  void push(size_t slot) {
+    slots_[slot]->push(ElemTy{});
+  }
+
+  void pop(size_t slot) {
+    if (!slots_[slot]->empty()) {
+      slots_[slot]->pop();
+    }
+  }
+
+ private:
+  std::vector<std::optional<Stack<ElemTy>>> slots_;
+  float grow_coeff_;
+};
+
+template <typename ElemTy>
+class ArenaSlots {
+ public:
+  ArenaSlots(size_t slots_cnt, float grow_coeff) : arena_(slots_cnt, grow_coeff) {}
+
+  void create(size_t slot, size_t size) {
+    destroy(slot);
+    for (size_t i = 0; i < size; ++i) {
+      arena_.push(slot, ElemTy{});
+    }
+  }
+
+  void destroy(size_t slot) {
+    while (!arena_.empty(slot)) {
+      arena_.pop(slot);
+    }
+  }
+
+  void push(size_t slot) {
+    arena_.push(slot, ElemTy{});
+  }
+
+  void pop(size_t slot) {
+    if (!arena_.empty(slot)) {
+      arena_.pop(slot);
+    }
+  }
+
+ private:
+  StackArena<ElemTy> arena_;
+};
+
+template <typename ElemTy>
+class PersistentSlots {
+ public:
+  explicit PersistentSlots(size_t slots_cnt) : slots_(slots_cnt) {}
+
+  void create(size_t slot, size_t size) {
+    destroy(slot);
+    for (size_t i = 0; i < size; ++i) {
+      slots_[slot].push(ElemTy{});
+    }
+  }
+
+  void destroy(size_t slot) {
+    slots_[slot] = PersistentStack<ElemTy, false>{};
+  }
+
+  void push(size_t slot) {
+    slots_[slot].push(ElemTy{});
+  }
+
+  void pop(size_t slot) {
+    if (!slots_[slot].empty()) {
+      slots_[slot].pop();
+    }
+  }
+
+ private:
+  std::vector<PersistentStack<ElemTy, false>> slots_;
+};
+
+template <typename SlotsTy, typename... ArgsTy>
+static void ReplayTrace(benchmark::State& state, const Replay& replay, ArgsTy... args) {
+  size_t peak_bytes = 0;
+  PerfCounters perf_counters{state};
+  for (auto _ : state) {
+    size_t base_bytes = AllocationCounter::allocated_bytes();
+    AllocationCounter::reset_peak();
+    {
+      SlotsTy slots(replay.slots_cnt_, args...);
+      for (const ReplayOp& op : replay.ops_) {
+        switch (op.op_) {
+          case Op::kCreate:
+            slots.create(op.slot_, op.arg_);
+            break;
+          case Op::kDestroy:
+            slots.destroy(op.slot_);
+            break;
+          case Op::kPush:
+            slots.push(op.slot_);
+            break;
+          case Op::kPop:
+            slots.pop(op.slot_);
+            break;
+          case Op::kGrow:
+          case Op::kMovedFrom:
+            break;
+        }
+      }
+      benchmark::DoNotOptimize(&slots);
+    }
+    peak_bytes = AllocationCounter::peak_bytes() - base_bytes;
+  }
+  state.counters["peak_bytes"] = peak_bytes;
+  state.SetItemsProcessed(state.iterations() * replay.ops_.size());
+}
+
+template <size_t ElemSize>
+static void register_policies(const Replay& replay) {
+  using ElemTy = Blob<ElemSize>;
+  std::string suffix = "/elem_size:" + std::to_string(ElemSize);
+
+  for (float grow_coeff : kGrowCoeffs) {
+    std::string coeff = "/grow_coeff:" + std::to_string(grow_coeff).substr(0, 4);
+    benchmark::RegisterBenchmark(("Stack" + coeff + suffix).c_str(),
+                                 [&replay, grow_coeff](benchmark::State& state) {
+                                   ReplayTrace<StackSlots<ElemTy>>(state, replay, grow_coeff);
+                                 });
+    benchmark::RegisterBenchmark(("StackArena" + coeff + suffix).c_str(),
+                                 [&replay, grow_coeff](benchmark::State& state) {
+                                   ReplayTrace<ArenaSlots<ElemTy>>(state, replay, grow_coeff);
+                                 });
+  }
+  benchmark::RegisterBenchmark(("PersistentStack" + suffix).c_str(),
+                               [&replay](benchmark::State& state) {
+                                 ReplayTrace<PersistentSlots<ElemTy>>(state, replay);
+                               });
+}
+
+static void register_policies_for(const Replay& replay) {
+  if (replay.elem_size_ <= 8) {
+    register_policies<8>(replay);
+  } else if (replay.elem_size_ <= 16) {
+    register_policies<16>(replay);
+  } else if (replay.elem_size_ <= 32) {
+    register_policies<32>(replay);
+  } else if (replay.elem_size_ <= 64) {
+    register_policies<64>(replay);
+  } else if (replay.elem_size_ <= 128) {
+    register_policies<128>(replay);
+  } else {
+    register_policies<256>(replay);
+  }
+}
+
+class ReplayReporter : public benchmark::ConsoleReporter {
+ public:
+  ReplayReporter() : ConsoleReporter(OO_Tabular) {}
+
+  void ReportRuns(const std::vector<Run>& runs) override {
+    for (const Run& run : runs) {
+      if (run.run_type != Run::RT_Iteration || run.error_occurred) {
+        continue;
+      }
+      double time = run.GetAdjustedRealTime();
+      if (time < fastest_time_) {
+        fastest_time_ = time;
+        fastest_name_ = run.benchmark_name();
+        time_unit_ = benchmark::GetTimeUnitString(run.time_unit);
+      }
+      auto peak_bytes = run.counters.find("peak_bytes");
+      if (peak_bytes != run.counters.end() && peak_bytes->second.value < smallest_bytes_) {
+        smallest_bytes_ = peak_bytes->second.value;
+        smallest_name_ = run.benchmark_name();
+      }
+    }
+    ConsoleReporter::ReportRuns(runs);
+  }
+
+  void Finalize() override {
+    ConsoleReporter::Finalize();
+    if (fastest_name_.empty()) {
+      return;
+    }
+    GetOutputStream() << "fastest:       " << fastest_name_ << " (" << fastest_time_ << " "
+                      << time_unit_ << ")\n"
+                      << "smallest peak: " << smallest_name_ << " (" << smallest_bytes_
+                      << " bytes)\n";
+  }
+
+ private:
+  double fastest_time_{std::numeric_limits<double>::max()};
+  double smallest_bytes_{std::numeric_limits<double>::max()};
+  std::string fastest_name_;
+  std::string smallest_name_;
+  const char* time_unit_{""};
+};
+
+int main(int argc, char** argv) {
+  benchmark::Initialize(&argc, argv);
+
+  Replay replay;
+  try {
+    if (argc > 1) {
+      replay = compile(StackTracer::read(argv[1]));
+    } else {
+      std::string path = record_synthetic_trace();
+      replay = compile(StackTracer::read(path));
+      std::remove(path.c_str());
+    }
+  } catch (const std::exception& e) {
+    std::cerr << argv[0] << ": " << e.what() << '\n';
+    return 1;
+  }
+  std::cout << "replaying " << replay.ops_.size() << " operations on " << replay.slots_cnt_
+            << " stack slots";
+  if (replay.skipped_cnt_ != 0) {
+    std::cout << ", skipped " << replay.skipped_cnt_ << " Stack<bool> records";
+  }
+  std::cout << '\n';
+
+  register_policies_for(replay);
+  ReplayReporter reporter;
+  benchmark::RunSpecifiedBenchmarks(&reporter);
+  benchmark::Shutdown();
+  return 0;
+}
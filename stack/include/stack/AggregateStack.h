@@ -0,0 +1,76 @@
+#ifndef STACK_AGGREGATE_STACK_H
+#define STACK_AGGREGATE_STACK_H
+
+#include <cstddef>
+
+#include "stack/Stack.h"
+
+template <typename ElemTy>
+struct MinOp {
+  ElemTy operator()(const ElemTy& lhs, const ElemTy& rhs) const;
+};
+
+template <typename ElemTy>
+struct MaxOp {
+  ElemTy operator()(const ElemTy& lhs, const ElemTy& rhs) const;
+};
+
+template <typename ElemTy>
+struct SumOp {
+  ElemTy operator()(const ElemTy& lhs, const ElemTy& rhs) const;
+};
+
+template <typename ElemTy, typename OpTy>
+class AggregateStack {
+ public:
+  explicit AggregateStack(OpTy op = OpTy{}, float grow_coeff = 1.5);
+
+  [[nodiscard]] const ElemTy& top() const;
+  [[nodiscard]] const ElemTy& aggregate() const;
+
+  [[nodiscard]] bool empty() const;
+  [[nodiscard]] size_t size() const;
+
+  void push(ElemTy val);
+  void pop();
+
+ private:
+  struct Run {
+    ElemTy aggregate_;
+    size_t cnt_;
+  };
+
+  Stack<ElemTy> values_;
+  Stack<Run> runs_;
+  OpTy op_;
+};
+
+template <typename ElemTy, typename OpTy>
+class AggregateQueue {
+ public:
+  explicit AggregateQueue(OpTy op = OpTy{}, float grow_coeff = 1.5);
+
+  [[nodiscard]] const ElemTy& front() const;
+  [[nodiscard]] ElemTy aggregate() const;
+
+  [[nodiscard]] bool empty() const;
+  [[nodiscard]] size_t size() const;
+
+  void push(ElemTy val);
+  void pop();
+
+ private:
+  struct FlippedOp {
+    OpTy op_;
+
+    ElemTy operator()(const ElemTy& lhs, const ElemTy& rhs) const;
+  };
+
+  AggregateStack<ElemTy, OpTy> back_;
+  AggregateStack<ElemTy, FlippedOp> front_;
+  OpTy op_;
+
+  void transfer();
+};
+
+#endif /* STACK_AGGREGATE_STACK_H */
@@ -0,0 +1,136 @@
+#ifndef STACK_AGGREGATE_STACK_IMPL_H
+#define STACK_AGGREGATE_STACK_IMPL_H
+
+#include <cassert>
+#include <utility>
+
+#include "stack/AggregateStack.h"
+#include "stack/Stack_impl.h"
+
+template <typename ElemTy>
+ElemTy MinOp<ElemTy>::operator()(const ElemTy& lhs, const ElemTy& rhs) const {
+  return rhs < lhs ? rhs : lhs;
+}
+
+template <typename ElemTy>
+ElemTy MaxOp<ElemTy>::operator()(const ElemTy& lhs, const ElemTy& rhs) const {
+  return lhs < rhs ? rhs : lhs;
+}
+
+template <typename ElemTy>
+ElemTy SumOp<ElemTy>::operator()(const ElemTy& lhs, const ElemTy& rhs) const {
+  return lhs + rhs;
+}
+
+template <typename ElemTy, typename OpTy>
+AggregateStack<ElemTy, OpTy>::AggregateStack(OpTy op, float grow_coeff)
+    : values_(grow_coeff), runs_(grow_coeff), op_(std::move(op)) {}
+
+template <typename ElemTy, typename OpTy>
+const ElemTy& AggregateStack<ElemTy, OpTy>::top() const {
+  return values_.top();
+}
+
+template <typename ElemTy, typename OpTy>
+const ElemTy& AggregateStack<ElemTy, OpTy>::aggregate() const {
+  return runs_.top().aggregate_;
+}
+
+template <typename ElemTy, typename OpTy>
+bool AggregateStack<ElemTy, OpTy>::empty() const {
+  return values_.empty();
+}
+
+template <typename ElemTy, typename OpTy>
+size_t AggregateStack<ElemTy, OpTy>::size() const {
+  return values_.size();
+}
+
+template <typename ElemTy, typename OpTy>
+void AggregateStack<ElemTy, OpTy>::push(ElemTy val) {
+  if (runs_.empty()) {
+    runs_.push(Run{val, 1});
+    values_.push(std::move(val));
+    return;
+  }
+
+  Run& run = runs_.top();
+  ElemTy new_aggregate = op_(run.aggregate_, val);
+  if (new_aggregate == run.aggregate_) {
+    ++run.cnt_;
+  } else {
+    runs_.push(Run{std::move(new_aggregate), 1});
+  }
+  values_.push(std::move(val));
+}
+
+template <typename ElemTy, typename OpTy>
+void AggregateStack<ElemTy, OpTy>::pop() {
+  assert(!empty());
+  values_.pop();
+  if (--runs_.top().cnt_ == 0) {
+    runs_.pop();
+  }
+}
+
+template <typename ElemTy, typename OpTy>
+ElemTy AggregateQueue<ElemTy, OpTy>::FlippedOp::operator()(const ElemTy& lhs,
+                                                          const ElemTy& rhs) const {
+  return op_(rhs, lhs);
+}
+
+template <typename ElemTy, typename OpTy>
+AggregateQueue<ElemTy, OpTy>::AggregateQueue(OpTy op, float grow_coeff)
+    : back_(op, grow_coeff), front_(FlippedOp{op}, grow_coeff), op_(std::move(op)) {}
+
+template <typename ElemTy, typename OpTy>
+const ElemTy& AggregateQueue<ElemTy, OpTy>::front() const {
+  return front_.top();
+}
+
+template <typename ElemTy, typename OpTy>
+ElemTy AggregateQueue<ElemTy, OpTy>::aggregate() const {
+  assert(!empty());
+  if (back_.empty()) {
+    return front_.aggregate();
+  }
+  return op_(front_.aggregate(), back_.aggregate());
+}
+
+template <typename ElemTy, typename OpTy>
+bool AggregateQueue<ElemTy, OpTy>::empty() const {
+  return front_.empty();
+}
+
+template <typename ElemTy, typename OpTy>
+size_t AggregateQueue<ElemTy, OpTy>::size() const {
+  return front_.size() + back_.size();
+}
+
+template <typename ElemTy, typename OpTy>
+void AggregateQueue<ElemTy, OpTy>::push(ElemTy val) {
+  if (front_.empty()) {
+    front_.push(std::move(val));
+    return;
+  }
+  back_.push(std::move(val));
+}
+
+template <typename ElemTy, typename OpTy>
+void AggregateQueue<ElemTy, OpTy>::pop() {
+  assert(!empty());
+  front_.pop();
+  if (front_.empty()) {
+    transfer();
+  }
+}
+
+template <typename ElemTy, typename OpTy>
+void AggregateQueue<ElemTy, OpTy>::transfer() {
+  while (!back_.empty()) {
+    front_.push(back_.top());
+    back_.pop();
+  }
+}
+
+#endif /* STACK_AGGREGATE_STACK_IMPL_H */
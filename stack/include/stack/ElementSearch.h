@@ -0,0 +1,65 @@
+#ifndef STACK_ELEMENT_SEARCH_H
+#define STACK_ELEMENT_SEARCH_H
+
+#include <cstddef>
+#include <cstdint>
+
+class ElementSearch {
+ public:
+  template <typename ElemTy>
+  static size_t count(const ElemTy* data, size_t size, const ElemTy& val);
+
+  template <typename ElemTy>
+  static size_t find_last(const ElemTy* data, size_t size, const ElemTy& val);
+
+ private:
+  template <typename ElemTy>
+  struct Lane;
+
+  template <typename LaneTy>
+  static size_t count_lanes(const LaneTy* data, size_t size, LaneTy val);
+  template <typename LaneTy>
+  static size_t find_last_lanes(const LaneTy* data, size_t size, LaneTy val);
+
+  static bool has_avx2();
+
+  template <typename LaneTy>
+  static size_t count_scalar(const LaneTy* data, size_t size, LaneTy val);
+  template <typename LaneTy>
+  static size_t find_last_scalar(const LaneTy* data, size_t size, LaneTy val);
+
+#if defined(__x86_64__) || defined(__i386__)
+  template <typename LaneTy>
+  static size_t count_sse(const LaneTy* data, size_t size, LaneTy val);
+  template <typename LaneTy>
+  static size_t find_last_sse(const LaneTy* data, size_t size, LaneTy val);
+
+  template <typename LaneTy>
+  __attribute__((target("avx2"))) static size_t count_avx2(const LaneTy* data,
+                                                            size_t size,
+                                                            LaneTy val);
+  template <typename LaneTy>
+  __attribute__((target("avx2"))) static size_t find_last_avx2(const LaneTy* data,
+                                                                size_t size,
+                                                                LaneTy val);
+
+  static uint32_t eq_mask_sse(const uint8_t* data, uint8_t val);
+  static uint32_t eq_mask_sse(const uint16_t* data, uint16_t val);
+  static uint32_t eq_mask_sse(const uint32_t* data, uint32_t val);
+  static uint32_t eq_mask_sse(const uint64_t* data, uint64_t val);
+  static uint32_t eq_mask_sse(const float* data, float val);
+  static uint32_t eq_mask_sse(const double* data, double val);
+
+  __attribute__((target("avx2"))) static uint32_t eq_mask_avx2(const uint8_t* data, uint8_t val);
+  __attribute__((target("avx2"))) static uint32_t eq_mask_avx2(const uint16_t* data,
+                                                                uint16_t val);
+  __attribute__((target("avx2"))) static uint32_t eq_mask_avx2(const uint32_t* data,
+                                                                uint32_t val);
+  __attribute__((target("avx2"))) static uint32_t eq_mask_avx2(const uint64_t* data,
+                                                                uint64_t val);
+  __attribute__((target("avx2"))) static uint32_t eq_mask_avx2(const float* data, float val);
+  __attribute__((target("avx2"))) static uint32_t eq_mask_avx2(const double* data, double val);
+#endif
+};
+
+#endif /* STACK_ELEMENT_SEARCH_H */
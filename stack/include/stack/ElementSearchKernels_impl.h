@@ -0,0 +1,197 @@
+#ifndef STACK_ELEMENT_SEARCH_KERNELS_IMPL_H
+#define STACK_ELEMENT_SEARCH_KERNELS_IMPL_H
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+#include "stack/ElementSearch.h"
+
+template <typename LaneTy>
+size_t ElementSearch::count_lanes(const LaneTy* data, size_t size, LaneTy val) {
+#if defined(__x86_64__) || defined(__i386__)
+  if (has_avx2()) {
+    return count_avx2(data, size, val);
+  }
+  return count_sse(data, size, val);
+#else
+  return count_scalar(data, size, val);
+#endif
+}
+
+template <typename LaneTy>
+size_t ElementSearch::find_last_lanes(const LaneTy* data, size_t size, LaneTy val) {
+#if defined(__x86_64__) || defined(__i386__)
+  if (has_avx2()) {
+    return find_last_avx2(data, size, val);
+  }
+  return find_last_sse(data, size, val);
+#else
+  return find_last_scalar(data, size, val);
+#endif
+}
+
+inline bool ElementSearch::has_avx2() {
+#if defined(__x86_64__) || defined(__i386__)
+  static const bool supported = __builtin_cpu_supports("avx2");
+  return supported;
+#else
+  return false;
+#endif
+}
+
+template <typename LaneTy>
+size_t ElementSearch::count_scalar(const LaneTy* data, size_t size, LaneTy val) {
+  size_t cnt = 0;
+  for (size_t i = 0; i < size; ++i) {
+    if (data[i] == val) {
+      ++cnt;
+    }
+  }
+  return cnt;
+}
+
+template <typename LaneTy>
+size_t ElementSearch::find_last_scalar(const LaneTy* data, size_t size, LaneTy val) {
+  for (size_t i = size; i-- > 0;) {
+    if (data[i] == val) {
+      return i;
+    }
+  }
+  return size;
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+template <typename LaneTy>
+size_t ElementSearch::count_sse(const LaneTy* data, size_t size, LaneTy val) {
+  const size_t lanes_cnt = sizeof(__m128i) / sizeof(LaneTy);
+  size_t matched_bytes = 0;
+  size_t i = 0;
+  for (; i + lanes_cnt <= size; i += lanes_cnt) {
+    matched_bytes += __builtin_popcount(eq_mask_sse(data + i, val));
+  }
+  return matched_bytes / sizeof(LaneTy) + count_scalar(data + i, size - i, val);
+}
+
+template <typename LaneTy>
+size_t ElementSearch::find_last_sse(const LaneTy* data, size_t size, LaneTy val) {
+  const size_t lanes_cnt = sizeof(__m128i) / sizeof(LaneTy);
+  size_t i = size;
+  for (; i >= lanes_cnt; i -= lanes_cnt) {
+    uint32_t mask = eq_mask_sse(data + i - lanes_cnt, val);
+    if (mask != 0) {
+      return i - lanes_cnt + (31 - __builtin_clz(mask)) / sizeof(LaneTy);
+    }
+  }
+
+  size_t idx = find_last_scalar(data, i, val);
+  return idx == i ? size : idx;
+}
+
+template <typename LaneTy>
+__attribute__((target("avx2"))) size_t ElementSearch::count_avx2(const LaneTy* data,
+                                                                  size_t size,
+                                                                  LaneTy val) {
+  const size_t lanes_cnt = sizeof(__m256i) / sizeof(LaneTy);
+  size_t matched_bytes = 0;
+  size_t i = 0;
+  for (; i + lanes_cnt <= size; i += lanes_cnt) {
+    matched_bytes += __builtin_popcount(eq_mask_avx2(data + i, val));
+  }
+  return matched_bytes / sizeof(LaneTy) + count_scalar(data + i, size - i, val);
+}
+
+template <typename LaneTy>
+__attribute__((target("avx2"))) size_t ElementSearch::find_last_avx2(const LaneTy* data,
+                                                                      size_t size,
+                                                                      LaneTy val) {
+  const size_t lanes_cnt = sizeof(__m256i) / sizeof(LaneTy);
+  size_t i = size;
+  for (; i >= lanes_cnt; i -= lanes_cnt) {
+    uint32_t mask = eq_mask_avx2(data + i - lanes_cnt, val);
+    if (mask != 0) {
+      return i - lanes_cnt + (31 - __builtin_clz(mask)) / sizeof(LaneTy);
+    }
+  }
+
+  size_t idx = find_last_scalar(data, i, val);
+  return idx == i ? size : idx;
+}
+
+inline uint32_t ElementSearch::eq_mask_sse(const uint8_t* data, uint8_t val) {
+  __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+  __m128i eq = _mm_cmpeq_epi8(block, _mm_set1_epi8(static_cast<char>(val)));
+  return static_cast<uint32_t>(_mm_movemask_epi8(eq));
+}
+
+inline uint32_t ElementSearch::eq_mask_sse(const uint16_t* data, uint16_t val) {
+  __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+  __m128i eq = _mm_cmpeq_epi16(block, _mm_set1_epi16(static_cast<short>(val)));
+  return static_cast<uint32_t>(_mm_movemask_epi8(eq));
+}
+
+inline uint32_t ElementSearch::eq_mask_sse(const uint32_t* data, uint32_t val) {
+  __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+  __m128i eq = _mm_cmpeq_epi32(block, _mm_set1_epi32(static_cast<int>(val)));
+  return static_cast<uint32_t>(_mm_movemask_epi8(eq));
+}
+
+inline uint32_t ElementSearch::eq_mask_sse(const uint64_t* data, uint64_t val) {
+  __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+  __m128i halves_eq = _mm_cmpeq_epi32(block, _mm_set1_epi64x(static_cast<long long>(val)));
+  __m128i eq = _mm_and_si128(halves_eq, _mm_shuffle_epi32(halves_eq, _MM_SHUFFLE(2, 3, 0, 1)));
+  return static_cast<uint32_t>(_mm_movemask_epi8(eq));
+}
+
+inline uint32_t ElementSearch::eq_mask_sse(const float* data, float val) {
+  __m128 eq = _mm_cmpeq_ps(_mm_loadu_ps(data), _mm_set1_ps(val));
+  return static_cast<uint32_t>(_mm_movemask_epi8(_mm_castps_si128(eq)));
+}
+
+inline uint32_t ElementSearch::eq_mask_sse(const double* data, double val) {
+  __m128d eq = _mm_cmpeq_pd(_mm_loadu_pd(data), _mm_set1_pd(val));
+  return static_cast<uint32_t>(_mm_movemask_epi8(_mm_castpd_si128(eq)));
+}
+
+__attribute__((target("avx2"))) inline uint32_t ElementSearch::eq_mask_avx2(const uint8_t* data,
+                                                                             uint8_t val) {
+  __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+  __m256i eq = _mm256_cmpeq_epi8(block, _mm256_set1_epi8(static_cast<char>(val)));
+  return static_cast<uint32_t>(_mm256_movemask_epi8(eq));
+}
+
+__attribute__((target("avx2"))) inline uint32_t ElementSearch::eq_mask_avx2(const uint16_t* data,
+                                                                             uint16_t val) {
+  __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+  __m256i eq = _mm256_cmpeq_epi16(block, _mm256_set1_epi16(static_cast<short>(val)));
+  return static_cast<uint32_t>(_mm256_movemask_epi8(eq));
+}
+
+__attribute__((target("avx2"))) inline uint32_t ElementSearch::eq_mask_avx2(const uint32_t* data,
+                                                                             uint32_t val) {
+  __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+  __m256i eq = _mm256_cmpeq_epi32(block, _mm256_set1_epi32(static_cast<int>(val)));
+  return static_cast<uint32_t>(_mm256_movemask_epi8(eq));
+}
+
+__attribute__((target("avx2"))) inline uint32_t ElementSearch::eq_mask_avx2(const uint64_t* data,
+                                                                             uint64_t val) {
+  __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+  __m256i eq = _mm256_cmpeq_epi64(block, _mm256_set1_epi64x(static_cast<long long>(val)));
+  return static_cast<uint32_t>(_mm256_movemask_epi8(eq));
+}
+
+__attribute__((target("avx2"))) inline uint32_t ElementSearch::eq_mask_avx2(const float* data,
+                                                                             float val) {
+  __m256 eq = _mm256_cmp_ps(_mm256_loadu_ps(data), _mm256_set1_ps(val), _CMP_EQ_OQ);
+  return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_castps_si256(eq)));
+}
+
+__attribute__((target("avx2"))) inline uint32_t ElementSearch::eq_mask_avx2(const double* data,
+                                                                             double val) {
+  __m256d eq = _mm256_cmp_pd(_mm256_loadu_pd(data), _mm256_set1_pd(val), _CMP_EQ_OQ);
+  return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_castpd_si256(eq)));
+}
+#endif
+
+#endif /* STACK_ELEMENT_SEARCH_KERNELS_IMPL_H */
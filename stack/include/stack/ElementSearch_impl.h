@@ -0,0 +1,66 @@
+#ifndef STACK_ELEMENT_SEARCH_IMPL_H
+#define STACK_ELEMENT_SEARCH_IMPL_H
+
+#include <cstring>
+#include <type_traits>
+
+#include "stack/ElementSearch.h"
+
+template <typename ElemTy>
+struct ElementSearch::Lane {
+  using IntegralTy = std::conditional_t<
+      sizeof(ElemTy) == 1,
+      uint8_t,
+      std::conditional_t<
+          sizeof(ElemTy) == 2,
+          uint16_t,
+          std::conditional_t<sizeof(ElemTy) == 4,
+                             uint32_t,
+                             std::conditional_t<sizeof(ElemTy) == 8, uint64_t, void>>>>;
+
+  using Type = std::conditional_t<
+      std::is_same_v<ElemTy, float> || std::is_same_v<ElemTy, double>,
+      ElemTy,
+      std::conditional_t<std::is_integral_v<ElemTy>, IntegralTy, void>>;
+};
+
+template <typename ElemTy>
+size_t ElementSearch::count(const ElemTy* data, size_t size, const ElemTy& val) {
+  using LaneTy = typename Lane<ElemTy>::Type;
+  if constexpr (std::is_void_v<LaneTy>) {
+    size_t cnt = 0;
+    for (size_t i = 0; i < size; ++i) {
+      if (data[i] == val) {
+        ++cnt;
+      }
+    }
+    return cnt;
+  } else {
+    LaneTy lane_val;
+    std::memcpy(&lane_val, &val, sizeof(lane_val));
+    return count_lanes(reinterpret_cast<const LaneTy*>(data), size, lane_val);
+  }
+}
+
+template <typename ElemTy>
+size_t ElementSearch::find_last(const ElemTy* data, size_t size, const ElemTy& val) {
+  using LaneTy = typename Lane<ElemTy>::Type;
+  if constexpr (std::is_void_v<LaneTy>) {
+    for (size_t i = size; i-- > 0;) {
+      if (data[i] == val) {
+        return i;
+      }
+    }
+    return size;
+  } else {
+    LaneTy lane_val;
+    std::memcpy(&lane_val, &val, sizeof(lane_val));
+    return find_last_lanes(reinterpret_cast<const LaneTy*>(data), size, lane_val);
+  }
+}
+
+#ifndef STACK_EXTERN_TEMPLATES
+#include "stack/ElementSearchKernels_impl.h"
+#endif
+
+#endif /* STACK_ELEMENT_SEARCH_IMPL_H */
@@ -0,0 +1,89 @@
+#ifndef STACK_MAGAZINE_DEPOT_H
+#define STACK_MAGAZINE_DEPOT_H
+
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <optional>
+
+#include "stack/Stack.h"
+
+template <typename ElemTy>
+class MagazineCache;
+
+template <typename ElemTy>
+class MagazineDepot {
+ public:
+  using ReclaimHookTy = std::function<void(ElemTy)>;
+
+  static const size_t kDefaultMagazineSize = 64;
+
+  explicit MagazineDepot(size_t magazine_size = kDefaultMagazineSize,
+                         ReclaimHookTy reclaim_hook = {});
+  MagazineDepot(const MagazineDepot& other) = delete;
+  MagazineDepot(MagazineDepot&& other) = delete;
+
+  ~MagazineDepot();
+
+  MagazineDepot& operator=(const MagazineDepot& rhs) = delete;
+  MagazineDepot& operator=(MagazineDepot&& other) = delete;
+
+  [[nodiscard]] size_t magazine_size() const;
+  [[nodiscard]] size_t full_magazines_cnt() const;
+  [[nodiscard]] size_t empty_magazines_cnt() const;
+
+  void reclaim(size_t keep_full_cnt = 0);
+
+ private:
+  friend class MagazineCache<ElemTy>;
+
+  using MagazineTy = Stack<ElemTy>;
+
+  size_t magazine_size_;
+  ReclaimHookTy reclaim_hook_;
+
+  mutable std::mutex mutex_;
+  Stack<MagazineTy*> full_;
+  Stack<MagazineTy*> empty_;
+  MagazineTy* partial_{nullptr};
+
+  MagazineTy* make_magazine() const;
+
+  MagazineTy* exchange_full(MagazineTy* full);
+  MagazineTy* exchange_empty(MagazineTy* empty);
+  void put(MagazineTy* magazine);
+
+  void deposit(MagazineTy* magazine);
+  void drain(MagazineTy* magazine);
+};
+
+template <typename ElemTy>
+class MagazineCache {
+ public:
+  explicit MagazineCache(MagazineDepot<ElemTy>& depot);
+  MagazineCache(const MagazineCache& other) = delete;
+  MagazineCache(MagazineCache&& other) = delete;
+
+  ~MagazineCache();
+
+  MagazineCache& operator=(const MagazineCache& rhs) = delete;
+  MagazineCache& operator=(MagazineCache&& other) = delete;
+
+  [[nodiscard]] size_t size() const;
+
+  void push(ElemTy val);
+  std::optional<ElemTy> pop();
+
+  void flush();
+
+ private:
+  using MagazineTy = typename MagazineDepot<ElemTy>::MagazineTy;
+
+  MagazineDepot<ElemTy>& depot_;
+  MagazineTy* loaded_;
+  MagazineTy* previous_;
+
+  [[nodiscard]] bool full(const MagazineTy* magazine) const;
+};
+
+#endif /* STACK_MAGAZINE_DEPOT_H */
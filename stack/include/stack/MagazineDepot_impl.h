@@ -0,0 +1,216 @@
+#ifndef STACK_MAGAZINE_DEPOT_IMPL_H
+#define STACK_MAGAZINE_DEPOT_IMPL_H
+
+#include <cassert>
+#include <utility>
+
+#include "stack/MagazineDepot.h"
+#include "stack/Stack_impl.h"
+
+template <typename ElemTy>
+MagazineDepot<ElemTy>::MagazineDepot(size_t magazine_size, ReclaimHookTy reclaim_hook)
+    : magazine_size_(magazine_size), reclaim_hook_(std::move(reclaim_hook)) {
+  assert(magazine_size_ > 0);
+}
+
+template <typename ElemTy>
+MagazineDepot<ElemTy>::~MagazineDepot() {
+  if (partial_ != nullptr) {
+    drain(partial_);
+    delete partial_;
+  }
+  while (!full_.empty()) {
+    drain(full_.top());
+    delete full_.top();
+    full_.pop();
+  }
+  while (!empty_.empty()) {
+    delete empty_.top();
+    empty_.pop();
+  }
+}
+
+template <typename ElemTy>
+size_t MagazineDepot<ElemTy>::magazine_size() const {
+  return magazine_size_;
+}
+
+template <typename ElemTy>
+size_t MagazineDepot<ElemTy>::full_magazines_cnt() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return full_.size();
+}
+
+template <typename ElemTy>
+size_t MagazineDepot<ElemTy>::empty_magazines_cnt() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return empty_.size();
+}
+
+template <typename ElemTy>
+void MagazineDepot<ElemTy>::reclaim(size_t keep_full_cnt) {
+  Stack<MagazineTy*> reclaimed;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (full_.size() > keep_full_cnt) {
+      size_t excess = full_.size() - keep_full_cnt;
+      Stack<MagazineTy*> kept;
+      for (size_t i = 0; i < full_.size(); ++i) {
+        (i < excess ? reclaimed : kept).push(full_.data()[i]);
+      }
+      full_.swap(kept);
+    }
+    while (!empty_.empty()) {
+      reclaimed.push(empty_.top());
+      empty_.pop();
+    }
+    if (partial_ != nullptr) {
+      reclaimed.push(partial_);
+      partial_ = nullptr;
+    }
+  }
+
+  while (!reclaimed.empty()) {
+    drain(reclaimed.top());
+    delete reclaimed.top();
+    reclaimed.pop();
+  }
+}
+
+template <typename ElemTy>
+typename MagazineDepot<ElemTy>::MagazineTy* MagazineDepot<ElemTy>::make_magazine() const {
+  auto* magazine = new MagazineTy;
+  magazine->reserve(magazine_size_);
+  return magazine;
+}
+
+template <typename ElemTy>
+typename MagazineDepot<ElemTy>::MagazineTy* MagazineDepot<ElemTy>::exchange_full(
+    MagazineTy* full) {
+  MagazineTy* empty = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    deposit(full);
+    if (!empty_.empty()) {
+      empty = empty_.top();
+      empty_.pop();
+    }
+  }
+  return empty != nullptr ? empty : make_magazine();
+}
+
+template <typename ElemTy>
+typename MagazineDepot<ElemTy>::MagazineTy* MagazineDepot<ElemTy>::exchange_empty(
+    MagazineTy* empty) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  MagazineTy* full = partial_;
+  if (!full_.empty()) {
+    full = full_.top();
+    full_.pop();
+  } else {
+    partial_ = nullptr;
+  }
+  if (full != nullptr) {
+    empty_.push(empty);
+  }
+  return full;
+}
+
+template <typename ElemTy>
+void MagazineDepot<ElemTy>::put(MagazineTy* magazine) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  deposit(magazine);
+}
+
+template <typename ElemTy>
+void MagazineDepot<ElemTy>::deposit(MagazineTy* magazine) {
+  if (partial_ != nullptr && !magazine->empty() && magazine->size() < magazine_size_) {
+    while (!magazine->empty() && partial_->size() < magazine_size_) {
+      partial_->push(std::move(magazine->top()));
+      magazine->pop();
+    }
+    if (partial_->size() == magazine_size_) {
+      full_.push(partial_);
+      partial_ = nullptr;
+    }
+  }
+
+  if (magazine->empty()) {
+    empty_.push(magazine);
+  } else if (magazine->size() >= magazine_size_) {
+    full_.push(magazine);
+  } else {
+    partial_ = magazine;
+  }
+}
+
+template <typename ElemTy>
+void MagazineDepot<ElemTy>::drain(MagazineTy* magazine) {
+  while (!magazine->empty()) {
+    if (reclaim_hook_) {
+      reclaim_hook_(std::move(magazine->top()));
+    }
+    magazine->pop();
+  }
+}
+
+template <typename ElemTy>
+MagazineCache<ElemTy>::MagazineCache(MagazineDepot<ElemTy>& depot)
+    : depot_(depot), loaded_(depot_.make_magazine()), previous_(depot_.make_magazine()) {}
+
+template <typename ElemTy>
+MagazineCache<ElemTy>::~MagazineCache() {
+  depot_.put(loaded_);
+  depot_.put(previous_);
+}
+
+template <typename ElemTy>
+size_t MagazineCache<ElemTy>::size() const {
+  return loaded_->size() + previous_->size();
+}
+
+template <typename ElemTy>
+void MagazineCache<ElemTy>::push(ElemTy val) {
+  if (full(loaded_)) {
+    if (full(previous_)) {
+      previous_ = depot_.exchange_full(previous_);
+    }
+    std::swap(loaded_, previous_);
+  }
+  loaded_->push(std::move(val));
+}
+
+template <typename ElemTy>
+std::optional<ElemTy> MagazineCache<ElemTy>::pop() {
+  if (loaded_->empty()) {
+    if (previous_->empty()) {
+      MagazineTy* full = depot_.exchange_empty(previous_);
+      if (full == nullptr) {
+        return std::nullopt;
+      }
+      previous_ = full;
+    }
+    std::swap(loaded_, previous_);
+  }
+
+  ElemTy val = std::move(loaded_->top());
+  loaded_->pop();
+  return val;
+}
+
+template <typename ElemTy>
+void MagazineCache<ElemTy>::flush() {
+  if (!loaded_->empty()) {
+    loaded_ = depot_.exchange_full(loaded_);
+  }
+  if (!previous_->empty()) {
+    previous_ = depot_.exchange_full(previous_);
+  }
+}
+
+template <typename ElemTy>
+bool MagazineCache<ElemTy>::full(const MagazineTy* magazine) const {
+  return magazine->size() >= depot_.magazine_size_;
+}
+
+#endif /* STACK_MAGAZINE_DEPOT_IMPL_H */
@@ -0,0 +1,34 @@
+#ifndef STACK_PARALLEL_STACK_H
+#define STACK_PARALLEL_STACK_H
+
+#include <cstddef>
+
+#include "stack/Stack.h"
+#include "stack/ThreadPool.h"
+
+class ParallelStack {
+ public:
+  template <typename ElemTy, bool CopyOnWrite = false, bool Hashed = false>
+  static Stack<ElemTy, CopyOnWrite, Hashed> copy(ParallelPolicy policy,
+                                                 const ElemTy* other_datum,
+                                                 size_t other_size,
+                                                 float grow_coeff = 1.5);
+  template <typename ElemTy, bool CopyOnWrite, bool Hashed>
+  static Stack<ElemTy, CopyOnWrite, Hashed> copy(ParallelPolicy policy,
+                                                 const Stack<ElemTy, CopyOnWrite, Hashed>& other);
+
+  template <typename ElemTy, bool CopyOnWrite, bool Hashed>
+  [[nodiscard]] static bool equals(ParallelPolicy policy,
+                                   const Stack<ElemTy, CopyOnWrite, Hashed>& lhs,
+                                   const Stack<ElemTy, CopyOnWrite, Hashed>& rhs);
+  template <typename ElemTy, bool CopyOnWrite, bool Hashed>
+  [[nodiscard]] static bool less(ParallelPolicy policy,
+                                 const Stack<ElemTy, CopyOnWrite, Hashed>& lhs,
+                                 const Stack<ElemTy, CopyOnWrite, Hashed>& rhs);
+
+ private:
+  static const size_t kGrainSize = 1 << 16;
+  static const size_t kBlockSize = 1 << 12;
+};
+
+#endif /* STACK_PARALLEL_STACK_H */
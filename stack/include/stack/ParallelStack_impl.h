@@ -0,0 +1,102 @@
+#ifndef STACK_PARALLEL_STACK_IMPL_H
+#define STACK_PARALLEL_STACK_IMPL_H
+
+#include <algorithm>
+#include <atomic>
+
+#include "stack/ParallelStack.h"
+#include "stack/Stack_impl.h"
+#include "stack/ThreadPool_impl.h"
+
+template <typename ElemTy, bool CopyOnWrite, bool Hashed>
+Stack<ElemTy, CopyOnWrite, Hashed> ParallelStack::copy(ParallelPolicy policy,
+                                                       const ElemTy* other_datum,
+                                                       size_t other_size,
+                                                       float grow_coeff) {
+  Stack<ElemTy, CopyOnWrite, Hashed> stack{other_datum, 0, grow_coeff};
+  stack.reallocate(other_size);
+  ElemTy* data = stack.data_;
+  policy.pool->parallel_for(other_size, kGrainSize, [data, other_datum](size_t begin, size_t end) {
+    std::copy(other_datum + begin, other_datum + end, data + begin);
+  });
+  stack.size_ = other_size;
+
+  if constexpr (Hashed) {
+    std::atomic<size_t> sum{0};
+    policy.pool->parallel_for(other_size, kGrainSize, [data, &sum](size_t begin, size_t end) {
+      RollingHash partial{0, begin};
+      for (size_t i = begin; i < end; ++i) {
+        partial.push(Stack<ElemTy, CopyOnWrite, Hashed>::element_hash(data[i]));
+      }
+      sum.fetch_add(partial.sum(), std::memory_order_relaxed);
+    });
+    stack.hash_ = RollingHash{sum.load(std::memory_order_relaxed), other_size};
+  }
+  stack.trace(StackTraceOp::kCreate, stack.size_);
+  return stack;
+}
+
+template <typename ElemTy, bool CopyOnWrite, bool Hashed>
+Stack<ElemTy, CopyOnWrite, Hashed> ParallelStack::copy(
+    ParallelPolicy policy, const Stack<ElemTy, CopyOnWrite, Hashed>& other) {
+  return copy<ElemTy, CopyOnWrite, Hashed>(policy, other.data_, other.size_, other.grow_coeff_);
+}
+
+template <typename ElemTy, bool CopyOnWrite, bool Hashed>
+bool ParallelStack::equals(ParallelPolicy policy,
+                           const Stack<ElemTy, CopyOnWrite, Hashed>& lhs,
+                           const Stack<ElemTy, CopyOnWrite, Hashed>& rhs) {
+  if (lhs.size_ != rhs.size_) {
+    return false;
+  }
+  if constexpr (Hashed) {
+    if (lhs.hash_ != rhs.hash_) {
+      return false;
+    }
+  }
+
+  std::atomic<bool> mismatch{false};
+  policy.pool->parallel_for(lhs.size_, kGrainSize, [&](size_t begin, size_t end) {
+    for (size_t block = begin; block < end; block += kBlockSize) {
+      if (mismatch.load(std::memory_order_relaxed)) {
+        return;
+      }
+
+      size_t block_end = std::min(end, block + kBlockSize);
+      if (!std::equal(lhs.data_ + block, lhs.data_ + block_end, rhs.data_ + block)) {
+        mismatch.store(true, std::memory_order_relaxed);
+        return;
+      }
+    }
+  });
+  return !mismatch.load(std::memory_order_relaxed);
+}
+
+template <typename ElemTy, bool CopyOnWrite, bool Hashed>
+bool ParallelStack::less(ParallelPolicy policy,
+                         const Stack<ElemTy, CopyOnWrite, Hashed>& lhs,
+                         const Stack<ElemTy, CopyOnWrite, Hashed>& rhs) {
+  if (lhs.size_ > rhs.size_) {
+    return false;
+  }
+
+  std::atomic<bool> mismatch{false};
+  policy.pool->parallel_for(lhs.size_, kGrainSize, [&](size_t begin, size_t end) {
+    for (size_t block = begin; block < end; block += kBlockSize) {
+      if (mismatch.load(std::memory_order_relaxed)) {
+        return;
+      }
+
+      size_t block_end = std::min(end, block + kBlockSize);
+      for (size_t i = block; i < block_end; ++i) {
+        if (lhs.data_[i] >= rhs.data_[i]) {
+          mismatch.store(true, std::memory_order_relaxed);
+          return;
+        }
+      }
+    }
+  });
+  return !mismatch.load(std::memory_order_relaxed);
+}
+
+#endif /* STACK_PARALLEL_STACK_IMPL_H */
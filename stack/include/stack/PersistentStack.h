@@ -0,0 +1,91 @@
+#ifndef STACK_PERSISTENT_STACK_H
+#define STACK_PERSISTENT_STACK_H
+
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+
+template <typename NodeTy>
+class NodePool {
+ public:
+  NodePool() = default;
+  NodePool(const NodePool& other) = delete;
+  NodePool(NodePool&& other) = delete;
+
+  ~NodePool();
+
+  NodePool& operator=(const NodePool& rhs) = delete;
+  NodePool& operator=(NodePool&& other) = delete;
+
+  static void* allocate();
+  static void deallocate(void* node);
+
+ private:
+  static const size_t kMaxFreeCnt = 4096;
+
+  static thread_local bool destroyed_;
+
+  struct FreeNode {
+    FreeNode* next_;
+  };
+
+  FreeNode* free_list_{nullptr};
+  size_t free_cnt_{0};
+
+  static NodePool& instance();
+
+  static void* allocate_node();
+  static void deallocate_node(void* node);
+};
+
+template <typename ElemTy, bool ThreadSafe = true>
+class PersistentStack {
+ public:
+  PersistentStack() = default;
+  PersistentStack(const ElemTy* other_datum, size_t other_size);
+  PersistentStack(const PersistentStack& other) noexcept;
+  PersistentStack(PersistentStack&& other) noexcept;
+
+  ~PersistentStack();
+
+  PersistentStack& operator=(const PersistentStack& rhs) noexcept;
+  PersistentStack& operator=(PersistentStack&& other) noexcept;
+
+  bool operator==(const PersistentStack& rhs) const;
+  bool operator!=(const PersistentStack& rhs) const;
+
+  void swap(PersistentStack& other) noexcept;
+
+  [[nodiscard]] const ElemTy& top() const;
+
+  [[nodiscard]] bool empty() const;
+  [[nodiscard]] size_t size() const;
+
+  void push(ElemTy val);
+  void pop();
+
+  [[nodiscard]] PersistentStack pushed(ElemTy val) const;
+  [[nodiscard]] PersistentStack popped() const;
+
+ private:
+  using RefCntTy = std::conditional_t<ThreadSafe, std::atomic<size_t>, size_t>;
+
+  struct Node {
+    ElemTy val_;
+    Node* next_;
+    RefCntTy ref_cnt_{1};
+  };
+
+  using Pool = NodePool<Node>;
+
+  Node* head_{nullptr};
+  size_t size_{0};
+
+  static void add_ref(Node* node);
+  static bool release_ref(Node* node);
+  static bool unique(const Node* node);
+
+  static void release(Node* node);
+};
+
+#endif /* STACK_PERSISTENT_STACK_H */
@@ -0,0 +1,263 @@
+#ifndef STACK_PERSISTENT_STACK_IMPL_H
+#define STACK_PERSISTENT_STACK_IMPL_H
+
+#include <cassert>
+#include <new>
+#include <utility>
+
+#include "stack/PersistentStack.h"
+
+template <typename NodeTy>
+thread_local bool NodePool<NodeTy>::destroyed_{false};
+
+template <typename NodeTy>
+NodePool<NodeTy>::~NodePool() {
+  destroyed_ = true;
+  while (free_list_ != nullptr) {
+    FreeNode* next = free_list_->next_;
+    deallocate_node(free_list_);
+    free_list_ = next;
+  }
+  free_cnt_ = 0;
+}
+
+template <typename NodeTy>
+NodePool<NodeTy>& NodePool<NodeTy>::instance() {
+  static thread_local NodePool pool;
+  return pool;
+}
+
+template <typename NodeTy>
+void* NodePool<NodeTy>::allocate_node() {
+  return ::operator new(sizeof(NodeTy), std::align_val_t{alignof(NodeTy)});
+}
+
+template <typename NodeTy>
+void NodePool<NodeTy>::deallocate_node(void* node) {
+  ::operator delete(node, sizeof(NodeTy), std::align_val_t{alignof(NodeTy)});
+}
+
+template <typename NodeTy>
+void* NodePool<NodeTy>::allocate() {
+  static_assert(sizeof(NodeTy) >= sizeof(FreeNode));
+  static_assert(alignof(NodeTy) >= alignof(FreeNode));
+
+  if (destroyed_) {
+    return allocate_node();
+  }
+
+  NodePool& pool = instance();
+  if (pool.free_list_ == nullptr) {
+    return allocate_node();
+  }
+
+  FreeNode* node = pool.free_list_;
+  pool.free_list_ = node->next_;
+  --pool.free_cnt_;
+  return node;
+}
+
+template <typename NodeTy>
+void NodePool<NodeTy>::deallocate(void* node) {
+  if (destroyed_) {
+    deallocate_node(node);
+    return;
+  }
+
+  NodePool& pool = instance();
+  if (pool.free_cnt_ == kMaxFreeCnt) {
+    deallocate_node(node);
+    return;
+  }
+
+  pool.free_list_ = new (node) FreeNode{pool.free_list_};
+  ++pool.free_cnt_;
+}
+
+template <typename ElemTy, bool ThreadSafe>
+PersistentStack<ElemTy, ThreadSafe>::PersistentStack(const ElemTy* other_datum, size_t other_size) {
+  for (size_t i = 0; i < other_size; ++i) {
+    push(other_datum[i]);
+  }
+}
+
+template <typename ElemTy, bool ThreadSafe>
+PersistentStack<ElemTy, ThreadSafe>::PersistentStack(const PersistentStack& other) noexcept
+    : head_(other.head_), size_(other.size_) {
+  if (head_ != nullptr) {
+    add_ref(head_);
+  }
+}
+
+template <typename ElemTy, bool ThreadSafe>
+PersistentStack<ElemTy, ThreadSafe>::PersistentStack(PersistentStack&& other) noexcept
+    : head_(other.head_), size_(other.size_) {
+  other.head_ = nullptr;
+  other.size_ = 0;
+}
+
+template <typename ElemTy, bool ThreadSafe>
+PersistentStack<ElemTy, ThreadSafe>::~PersistentStack() {
+  release(head_);
+}
+
+template <typename ElemTy, bool ThreadSafe>
+PersistentStack<ElemTy, ThreadSafe>& PersistentStack<ElemTy, ThreadSafe>::operator=(
+    const PersistentStack& rhs) noexcept {
+  if (head_ == rhs.head_) {
+    size_ = rhs.size_;
+    return *this;
+  }
+
+  if (rhs.head_ != nullptr) {
+    add_ref(rhs.head_);
+  }
+  release(head_);
+
+  head_ = rhs.head_;
+  size_ = rhs.size_;
+  return *this;
+}
+
+template <typename ElemTy, bool ThreadSafe>
+PersistentStack<ElemTy, ThreadSafe>& PersistentStack<ElemTy, ThreadSafe>::operator=(
+    PersistentStack&& other) noexcept {
+  if (this == &other) {
+    return *this;
+  }
+
+  release(head_);
+
+  head_ = other.head_;
+  size_ = other.size_;
+
+  other.head_ = nullptr;
+  other.size_ = 0;
+
+  return *this;
+}
+
+template <typename ElemTy, bool ThreadSafe>
+bool PersistentStack<ElemTy, ThreadSafe>::operator==(const PersistentStack& rhs) const {
+  if (size_ != rhs.size_) {
+    return false;
+  }
+
+  for (const Node *x = head_, *y = rhs.head_; x != y; x = x->next_, y = y->next_) {
+    if (x->val_ != y->val_) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename ElemTy, bool ThreadSafe>
+bool PersistentStack<ElemTy, ThreadSafe>::operator!=(const PersistentStack& rhs) const {
+  return !(*this == rhs);
+}
+
+template <typename ElemTy, bool ThreadSafe>
+void PersistentStack<ElemTy, ThreadSafe>::swap(PersistentStack& other) noexcept {
+  std::swap(head_, other.head_);
+  std::swap(size_, other.size_);
+}
+
+template <typename ElemTy, bool ThreadSafe>
+const ElemTy& PersistentStack<ElemTy, ThreadSafe>::top() const {
+  assert(!empty());
+  return head_->val_;
+}
+
+template <typename ElemTy, bool ThreadSafe>
+bool PersistentStack<ElemTy, ThreadSafe>::empty() const {
+  return size_ == 0;
+}
+
+template <typename ElemTy, bool ThreadSafe>
+size_t PersistentStack<ElemTy, ThreadSafe>::size() const {
+  return size_;
+}
+
+template <typename ElemTy, bool ThreadSafe>
+void PersistentStack<ElemTy, ThreadSafe>::push(ElemTy val) {
+  void* storage = Pool::allocate();
+  try {
+    head_ = new (storage) Node{std::move(val), head_};
+  } catch (...) {
+    Pool::deallocate(storage);
+    throw;
+  }
+  ++size_;
+}
+
+template <typename ElemTy, bool ThreadSafe>
+void PersistentStack<ElemTy, ThreadSafe>::pop() {
+  assert(!empty());
+  Node* old_head = head_;
+  head_ = old_head->next_;
+  --size_;
+
+  if (unique(old_head)) {
+    old_head->~Node();
+    Pool::deallocate(old_head);
+    return;
+  }
+
+  if (head_ != nullptr) {
+    add_ref(head_);
+  }
+  release(old_head);
+}
+
+template <typename ElemTy, bool ThreadSafe>
+PersistentStack<ElemTy, ThreadSafe> PersistentStack<ElemTy, ThreadSafe>::pushed(ElemTy val) const {
+  PersistentStack stack{*this};
+  stack.push(std::move(val));
+  return stack;
+}
+
+template <typename ElemTy, bool ThreadSafe>
+PersistentStack<ElemTy, ThreadSafe> PersistentStack<ElemTy, ThreadSafe>::popped() const {
+  PersistentStack stack{*this};
+  stack.pop();
+  return stack;
+}
+
+template <typename ElemTy, bool ThreadSafe>
+void PersistentStack<ElemTy, ThreadSafe>::add_ref(Node* node) {
+  if constexpr (ThreadSafe) {
+    node->ref_cnt_.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    ++node->ref_cnt_;
+  }
+}
+
+template <typename ElemTy, bool ThreadSafe>
+bool PersistentStack<ElemTy, ThreadSafe>::release_ref(Node* node) {
+  if constexpr (ThreadSafe) {
+    return node->ref_cnt_.fetch_sub(1, std::memory_order_acq_rel) == 1;
+  } else {
+    return --node->ref_cnt_ == 0;
+  }
+}
+
+template <typename ElemTy, bool ThreadSafe>
+bool PersistentStack<ElemTy, ThreadSafe>::unique(const Node* node) {
+  if constexpr (ThreadSafe) {
+    return node->ref_cnt_.load(std::memory_order_acquire) == 1;
+  } else {
+    return node->ref_cnt_ == 1;
+  }
+}
+
+template <typename ElemTy, bool ThreadSafe>
+void PersistentStack<ElemTy, ThreadSafe>::release(Node* node) {
+  while (node != nullptr && release_ref(node)) {
+    Node* next = node->next_;
+    node->~Node();
+    Pool::deallocate(node);
+    node = next;
+  }
+}
+
+#endif /* STACK_PERSISTENT_STACK_IMPL_H */
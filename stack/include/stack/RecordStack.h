@@ -0,0 +1,73 @@
+#ifndef STACK_RECORD_STACK_H
+#define STACK_RECORD_STACK_H
+
+#include <cstddef>
+#include <cstdint>
+
+class RecordStack {
+ public:
+  explicit RecordStack(size_t capacity = kDefaultCapacity, float grow_coeff = 1.5);
+  RecordStack(const RecordStack& other) = delete;
+  RecordStack(RecordStack&& other) noexcept;
+
+  ~RecordStack();
+
+  RecordStack& operator=(const RecordStack& rhs) = delete;
+  RecordStack& operator=(RecordStack&& other) noexcept;
+
+  template <typename RecordTy, typename... ArgsTy>
+  RecordTy& emplace(ArgsTy&&... args);
+
+  template <typename RecordTy>
+  RecordTy& top();
+  template <typename RecordTy>
+  [[nodiscard]] const RecordTy& top() const;
+
+  template <typename RecordTy>
+  void pop();
+
+  template <typename FuncTy>
+  void walk(FuncTy func);
+
+  [[nodiscard]] bool empty() const;
+  [[nodiscard]] size_t size() const;
+  [[nodiscard]] size_t bytes() const;
+
+ private:
+  static const size_t kDefaultCapacity = 4096;
+  static const size_t kAlignment = alignof(std::max_align_t);
+
+  enum class RecordOp { kRelocate, kDestroy };
+
+  using ManagerTy = void (*)(RecordOp op, void* dst, void* src);
+
+  struct RecordHeader {
+    ManagerTy manager_;
+    uint32_t object_offset_;
+    uint32_t record_size_;
+  };
+
+  std::byte* data_;
+  size_t top_{0};
+  size_t size_{0};
+  size_t capacity_;
+  float grow_coeff_;
+
+  template <typename RecordTy>
+  static void manage(RecordOp op, void* dst, void* src);
+
+  template <typename RecordTy>
+  static ManagerTy manager_for();
+
+  static size_t align_up(size_t offset, size_t alignment);
+
+  [[nodiscard]] RecordHeader& top_header();
+  [[nodiscard]] const RecordHeader& top_header() const;
+
+  static std::byte* allocate(size_t capacity);
+
+  void relocate(std::byte* new_datum, size_t new_capacity);
+  void destroy();
+};
+
+#endif /* STACK_RECORD_STACK_H */
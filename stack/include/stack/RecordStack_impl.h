@@ -0,0 +1,208 @@
+#ifndef STACK_RECORD_STACK_IMPL_H
+#define STACK_RECORD_STACK_IMPL_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "stack/RecordStack.h"
+
+inline RecordStack::RecordStack(size_t capacity, float grow_coeff)
+    : capacity_(capacity), grow_coeff_(grow_coeff) {
+  data_ = allocate(capacity_);
+}
+
+inline RecordStack::RecordStack(RecordStack&& other) noexcept
+    : data_(other.data_),
+      top_(other.top_),
+      size_(other.size_),
+      capacity_(other.capacity_),
+      grow_coeff_(other.grow_coeff_) {
+  other.data_ = nullptr;
+  other.capacity_ = other.top_ = other.size_ = 0;
+}
+
+inline RecordStack::~RecordStack() {
+  destroy();
+}
+
+inline RecordStack& RecordStack::operator=(RecordStack&& other) noexcept {
+  if (this == &other) {
+    return *this;
+  }
+
+  destroy();
+
+  data_ = other.data_;
+  top_ = other.top_;
+  size_ = other.size_;
+  capacity_ = other.capacity_;
+  grow_coeff_ = other.grow_coeff_;
+
+  other.data_ = nullptr;
+  other.capacity_ = other.top_ = other.size_ = 0;
+
+  return *this;
+}
+
+template <typename RecordTy, typename... ArgsTy>
+RecordTy& RecordStack::emplace(ArgsTy&&... args) {
+  static_assert(alignof(RecordTy) <= kAlignment);
+
+  size_t object_offset = align_up(top_, alignof(RecordTy));
+  size_t header_offset = align_up(object_offset + sizeof(RecordTy), alignof(RecordHeader));
+  size_t new_top = header_offset + sizeof(RecordHeader);
+  if (new_top - top_ > std::numeric_limits<uint32_t>::max()) {
+    throw std::length_error("RecordStack record exceeds the 32-bit record size");
+  }
+
+  RecordTy* object = nullptr;
+  if (new_top <= capacity_) {
+    object = new (data_ + object_offset) RecordTy(std::forward<ArgsTy>(args)...);
+  } else {
+    size_t new_capacity = std::max<size_t>(capacity_ * grow_coeff_ + 1, new_top);
+    std::byte* new_datum = allocate(new_capacity);
+    try {
+      object = new (new_datum + object_offset) RecordTy(std::forward<ArgsTy>(args)...);
+    } catch (...) {
+      ::operator delete(new_datum, std::align_val_t{kAlignment});
+      throw;
+    }
+    relocate(new_datum, new_capacity);
+  }
+  new (data_ + header_offset) RecordHeader{manager_for<RecordTy>(),
+                                           static_cast<uint32_t>(header_offset - object_offset),
+                                           static_cast<uint32_t>(new_top - top_)};
+  top_ = new_top;
+  ++size_;
+  return *object;
+}
+
+template <typename RecordTy>
+RecordTy& RecordStack::top() {
+  assert(!empty());
+  assert(top_header().manager_ == manager_for<RecordTy>());
+  auto* header = reinterpret_cast<std::byte*>(&top_header());
+  return *std::launder(reinterpret_cast<RecordTy*>(header - top_header().object_offset_));
+}
+
+template <typename RecordTy>
+const RecordTy& RecordStack::top() const {
+  assert(!empty());
+  assert(top_header().manager_ == manager_for<RecordTy>());
+  const auto* header = reinterpret_cast<const std::byte*>(&top_header());
+  return *std::launder(reinterpret_cast<const RecordTy*>(header - top_header().object_offset_));
+}
+
+template <typename RecordTy>
+void RecordStack::pop() {
+  RecordTy& object = top<RecordTy>();
+  size_t record_size = top_header().record_size_;
+  object.~RecordTy();
+  top_ -= record_size;
+  --size_;
+}
+
+template <typename FuncTy>
+void RecordStack::walk(FuncTy func) {
+  for (size_t offset = top_; offset != 0;) {
+    auto* header = std::launder(
+        reinterpret_cast<RecordHeader*>(data_ + offset - sizeof(RecordHeader)));
+    func(static_cast<void*>(reinterpret_cast<std::byte*>(header) - header->object_offset_));
+    offset -= header->record_size_;
+  }
+}
+
+inline bool RecordStack::empty() const {
+  return size_ == 0;
+}
+
+inline size_t RecordStack::size() const {
+  return size_;
+}
+
+inline size_t RecordStack::bytes() const {
+  return top_;
+}
+
+template <typename RecordTy>
+void RecordStack::manage(RecordOp op, void* dst, void* src) {
+  auto* object = std::launder(static_cast<RecordTy*>(src));
+  if (op == RecordOp::kRelocate) {
+    new (dst) RecordTy(std::move(*object));
+  }
+  object->~RecordTy();
+}
+
+template <typename RecordTy>
+RecordStack::ManagerTy RecordStack::manager_for() {
+  if constexpr (std::is_trivially_copyable_v<RecordTy> &&
+                std::is_trivially_destructible_v<RecordTy>) {
+    return nullptr;
+  } else {
+    return &manage<RecordTy>;
+  }
+}
+
+inline size_t RecordStack::align_up(size_t offset, size_t alignment) {
+  return (offset + alignment - 1) & ~(alignment - 1);
+}
+
+inline RecordStack::RecordHeader& RecordStack::top_header() {
+  return *std::launder(reinterpret_cast<RecordHeader*>(data_ + top_ - sizeof(RecordHeader)));
+}
+
+inline const RecordStack::RecordHeader& RecordStack::top_header() const {
+  return *std::launder(
+      reinterpret_cast<const RecordHeader*>(data_ + top_ - sizeof(RecordHeader)));
+}
+
+inline std::byte* RecordStack::allocate(size_t capacity) {
+  return static_cast<std::byte*>(::operator new(capacity, std::align_val_t{kAlignment}));
+}
+
+inline void RecordStack::relocate(std::byte* new_datum, size_t new_capacity) {
+  if (top_ != 0) {
+    std::memcpy(new_datum, data_, top_);
+  }
+
+  for (size_t offset = top_; offset != 0;) {
+    size_t header_offset = offset - sizeof(RecordHeader);
+    auto* header = std::launder(reinterpret_cast<RecordHeader*>(data_ + header_offset));
+    if (header->manager_ != nullptr) {
+      size_t object_offset = header_offset - header->object_offset_;
+      header->manager_(RecordOp::kRelocate, new_datum + object_offset, data_ + object_offset);
+    }
+    offset -= header->record_size_;
+  }
+
+  ::operator delete(data_, std::align_val_t{kAlignment});
+  data_ = new_datum;
+  capacity_ = new_capacity;
+}
+
+inline void RecordStack::destroy() {
+  if (data_ == nullptr) {
+    return;
+  }
+
+  for (size_t offset = top_; offset != 0;) {
+    size_t header_offset = offset - sizeof(RecordHeader);
+    auto* header = std::launder(reinterpret_cast<RecordHeader*>(data_ + header_offset));
+    if (header->manager_ != nullptr) {
+      size_t object_offset = header_offset - header->object_offset_;
+      header->manager_(RecordOp::kDestroy, nullptr, data_ + object_offset);
+    }
+    offset -= header->record_size_;
+  }
+
+  ::operator delete(data_, std::align_val_t{kAlignment});
+  data_ = nullptr;
+}
+
+#endif /* STACK_RECORD_STACK_IMPL_H */
@@ -0,0 +1,34 @@
+#ifndef STACK_ROLLING_HASH_H
+#define STACK_ROLLING_HASH_H
+
+#include <cstddef>
+
+class RollingHash {
+ public:
+  RollingHash() = default;
+  RollingHash(size_t sum, size_t size);
+
+  bool operator==(const RollingHash& rhs) const;
+  bool operator!=(const RollingHash& rhs) const;
+
+  static size_t mix(size_t val);
+  static size_t power(size_t exp);
+
+  [[nodiscard]] size_t sum() const;
+  [[nodiscard]] size_t value() const;
+
+  void push(size_t elem_hash);
+  void pop(size_t elem_hash);
+  void replace_top(size_t old_elem_hash, size_t new_elem_hash);
+
+ private:
+  static const size_t kBase = 0x9e3779b97f4a7c15;
+  static const size_t kBaseInverse = 0xf1de83e19937733d;
+
+  static_assert(kBase * kBaseInverse == 1);
+
+  size_t sum_{0};
+  size_t pow_{1};
+};
+
+#endif /* STACK_ROLLING_HASH_H */
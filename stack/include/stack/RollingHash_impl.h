@@ -0,0 +1,59 @@
+#ifndef STACK_ROLLING_HASH_IMPL_H
+#define STACK_ROLLING_HASH_IMPL_H
+
+#include "stack/RollingHash.h"
+
+inline RollingHash::RollingHash(size_t sum, size_t size) : sum_(sum), pow_(power(size)) {}
+
+inline bool RollingHash::operator==(const RollingHash& rhs) const {
+  return sum_ == rhs.sum_ && pow_ == rhs.pow_;
+}
+
+inline bool RollingHash::operator!=(const RollingHash& rhs) const {
+  return !(*this == rhs);
+}
+
+inline size_t RollingHash::mix(size_t val) {
+  val ^= val >> 30;
+  val *= 0xbf58476d1ce4e5b9;
+  val ^= val >> 27;
+  val *= 0x94d049bb133111eb;
+  val ^= val >> 31;
+  return val;
+}
+
+inline size_t RollingHash::power(size_t exp) {
+  size_t result = 1;
+  size_t base = kBase;
+  for (; exp != 0; exp >>= 1) {
+    if ((exp & 1) != 0) {
+      result *= base;
+    }
+    base *= base;
+  }
+  return result;
+}
+
+inline size_t RollingHash::sum() const {
+  return sum_;
+}
+
+inline size_t RollingHash::value() const {
+  return sum_ + pow_;
+}
+
+inline void RollingHash::push(size_t elem_hash) {
+  sum_ += elem_hash * pow_;
+  pow_ *= kBase;
+}
+
+inline void RollingHash::pop(size_t elem_hash) {
+  pow_ *= kBaseInverse;
+  sum_ -= elem_hash * pow_;
+}
+
+inline void RollingHash::replace_top(size_t old_elem_hash, size_t new_elem_hash) {
+  sum_ += (new_elem_hash - old_elem_hash) * (pow_ * kBaseInverse);
+}
+
+#endif /* STACK_ROLLING_HASH_IMPL_H */
@@ -0,0 +1,110 @@
+#ifndef STACK_SHARED_STACK_H
+#define STACK_SHARED_STACK_H
+
+#include <pthread.h>
+#include <sys/types.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <type_traits>
+
+template <typename ElemTy>
+class SharedStack {
+  static_assert(std::is_trivially_copyable_v<ElemTy>);
+
+ public:
+  SharedStack(std::string name, size_t capacity);
+  explicit SharedStack(std::string name);
+  SharedStack(const SharedStack& other) = delete;
+  SharedStack(SharedStack&& other) = delete;
+
+  ~SharedStack();
+
+  SharedStack& operator=(const SharedStack& rhs) = delete;
+  SharedStack& operator=(SharedStack&& other) = delete;
+
+  [[nodiscard]] const std::string& name() const;
+
+  [[nodiscard]] bool empty() const;
+  [[nodiscard]] size_t size() const;
+  [[nodiscard]] size_t capacity() const;
+  [[nodiscard]] size_t generation() const;
+
+  void push(ElemTy val);
+  std::optional<ElemTy> pop();
+
+ private:
+  static constexpr std::chrono::milliseconds kAttachTimeout{1000};
+  static constexpr std::chrono::milliseconds kAttachPollInterval{1};
+
+  static_assert(std::atomic<bool>::is_always_lock_free);
+
+  struct Header {
+    std::atomic<bool> initialized_;
+    pthread_mutex_t mutex_;
+    bool dirty_;
+    size_t size_;
+    size_t capacity_;
+    size_t generation_;
+  };
+
+  class Lock {
+   public:
+    explicit Lock(const SharedStack* stack);
+    Lock(const Lock& other) = delete;
+    Lock(Lock&& other) = delete;
+
+    ~Lock();
+
+    Lock& operator=(const Lock& rhs) = delete;
+    Lock& operator=(Lock&& other) = delete;
+
+   private:
+    const SharedStack* stack_;
+  };
+
+  class Mutation {
+   public:
+    explicit Mutation(Header* header);
+    Mutation(const Mutation& other) = delete;
+    Mutation(Mutation&& other) = delete;
+
+    ~Mutation();
+
+    Mutation& operator=(const Mutation& rhs) = delete;
+    Mutation& operator=(Mutation&& other) = delete;
+
+   private:
+    Header* header_;
+  };
+
+  std::string name_;
+  int fd_;
+  pid_t owner_pid_{-1};
+
+  Header* header_{nullptr};
+  ElemTy* data_{nullptr};
+  size_t mapped_capacity_{0};
+  size_t mapped_generation_{0};
+
+  static size_t header_bytes();
+  static size_t data_bytes(size_t capacity);
+
+  static void wait_step(std::chrono::steady_clock::time_point deadline);
+
+  [[nodiscard]] size_t object_bytes() const;
+  [[nodiscard]] bool consistent() const;
+
+  void open_object(int flags);
+  void close_object();
+  void map_header();
+  void init_mutex();
+  void wait_initialized();
+  void sync_mapping();
+  void grow();
+};
+
+#endif /* STACK_SHARED_STACK_H */
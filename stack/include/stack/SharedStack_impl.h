@@ -0,0 +1,285 @@
+#ifndef STACK_SHARED_STACK_IMPL_H
+#define STACK_SHARED_STACK_IMPL_H
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cassert>
+#include <cerrno>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+#include "stack/SharedStack.h"
+
+template <typename ElemTy>
+SharedStack<ElemTy>::Lock::Lock(const SharedStack* stack) : stack_(stack) {
+  int res = pthread_mutex_lock(&stack_->header_->mutex_);
+  if (res == EOWNERDEAD) {
+    bool recoverable = false;
+    try {
+      recoverable = stack_->consistent();
+    } catch (...) {
+      pthread_mutex_unlock(&stack_->header_->mutex_);
+      throw;
+    }
+    if (!recoverable) {
+      pthread_mutex_unlock(&stack_->header_->mutex_);
+      throw std::system_error(ENOTRECOVERABLE, std::generic_category(), "SharedStack header");
+    }
+    pthread_mutex_consistent(&stack_->header_->mutex_);
+  } else if (res != 0) {
+    throw std::system_error(res, std::generic_category(), "pthread_mutex_lock");
+  }
+}
+
+template <typename ElemTy>
+SharedStack<ElemTy>::Lock::~Lock() {
+  pthread_mutex_unlock(&stack_->header_->mutex_);
+}
+
+template <typename ElemTy>
+SharedStack<ElemTy>::Mutation::Mutation(Header* header) : header_(header) {
+  header_->dirty_ = true;
+  std::atomic_signal_fence(std::memory_order_seq_cst);
+}
+
+template <typename ElemTy>
+SharedStack<ElemTy>::Mutation::~Mutation() {
+  std::atomic_signal_fence(std::memory_order_seq_cst);
+  header_->dirty_ = false;
+}
+
+template <typename ElemTy>
+SharedStack<ElemTy>::SharedStack(std::string name, size_t capacity) : name_(std::move(name)) {
+  assert(capacity > 0);
+  open_object(O_CREAT | O_EXCL);
+  owner_pid_ = getpid();
+
+  try {
+    if (ftruncate(fd_, static_cast<off_t>(header_bytes() + data_bytes(capacity))) == -1) {
+      throw std::system_error(errno, std::generic_category(), "ftruncate");
+    }
+    map_header();
+    init_mutex();
+
+    header_->dirty_ = false;
+    header_->size_ = 0;
+    header_->capacity_ = capacity;
+    header_->generation_ = 0;
+    sync_mapping();
+  } catch (...) {
+    close_object();
+    throw;
+  }
+  header_->initialized_.store(true, std::memory_order_release);
+}
+
+template <typename ElemTy>
+SharedStack<ElemTy>::SharedStack(std::string name) : name_(std::move(name)) {
+  open_object(0);
+
+  try {
+    wait_initialized();
+
+    Lock lock{this};
+    sync_mapping();
+  } catch (...) {
+    close_object();
+    throw;
+  }
+}
+
+template <typename ElemTy>
+SharedStack<ElemTy>::~SharedStack() {
+  close_object();
+}
+
+template <typename ElemTy>
+const std::string& SharedStack<ElemTy>::name() const {
+  return name_;
+}
+
+template <typename ElemTy>
+bool SharedStack<ElemTy>::empty() const {
+  return size() == 0;
+}
+
+template <typename ElemTy>
+size_t SharedStack<ElemTy>::size() const {
+  Lock lock{this};
+  return header_->size_;
+}
+
+template <typename ElemTy>
+size_t SharedStack<ElemTy>::capacity() const {
+  Lock lock{this};
+  return header_->capacity_;
+}
+
+template <typename ElemTy>
+size_t SharedStack<ElemTy>::generation() const {
+  Lock lock{this};
+  return header_->generation_;
+}
+
+template <typename ElemTy>
+void SharedStack<ElemTy>::push(ElemTy val) {
+  Lock lock{this};
+  if (header_->size_ == header_->capacity_) {
+    grow();
+  }
+  sync_mapping();
+
+  Mutation mutation{header_};
+  data_[header_->size_] = val;
+  ++header_->size_;
+}
+
+template <typename ElemTy>
+std::optional<ElemTy> SharedStack<ElemTy>::pop() {
+  Lock lock{this};
+  if (header_->size_ == 0) {
+    return std::nullopt;
+  }
+  sync_mapping();
+
+  Mutation mutation{header_};
+  --header_->size_;
+  return data_[header_->size_];
+}
+
+template <typename ElemTy>
+size_t SharedStack<ElemTy>::header_bytes() {
+  auto page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  return (sizeof(Header) + page_size - 1) / page_size * page_size;
+}
+
+template <typename ElemTy>
+size_t SharedStack<ElemTy>::data_bytes(size_t capacity) {
+  return capacity * sizeof(ElemTy);
+}
+
+template <typename ElemTy>
+void SharedStack<ElemTy>::wait_step(std::chrono::steady_clock::time_point deadline) {
+  if (std::chrono::steady_clock::now() >= deadline) {
+    throw std::system_error(ETIMEDOUT, std::generic_category(), "SharedStack attach");
+  }
+  std::this_thread::sleep_for(kAttachPollInterval);
+}
+
+template <typename ElemTy>
+size_t SharedStack<ElemTy>::object_bytes() const {
+  struct stat st {};
+  if (fstat(fd_, &st) == -1) {
+    throw std::system_error(errno, std::generic_category(), "fstat");
+  }
+  return static_cast<size_t>(st.st_size);
+}
+
+template <typename ElemTy>
+bool SharedStack<ElemTy>::consistent() const {
+  return !header_->dirty_ && header_->size_ <= header_->capacity_ &&
+         object_bytes() >= header_bytes() + data_bytes(header_->capacity_);
+}
+
+template <typename ElemTy>
+void SharedStack<ElemTy>::open_object(int flags) {
+  fd_ = shm_open(name_.c_str(), O_RDWR | flags, 0600);
+  if (fd_ == -1) {
+    throw std::system_error(errno, std::generic_category(), "shm_open");
+  }
+}
+
+template <typename ElemTy>
+void SharedStack<ElemTy>::close_object() {
+  if (data_ != nullptr) {
+    munmap(data_, data_bytes(mapped_capacity_));
+  }
+  if (header_ != nullptr) {
+    munmap(header_, header_bytes());
+  }
+  close(fd_);
+  if (owner_pid_ == getpid()) {
+    shm_unlink(name_.c_str());
+  }
+}
+
+template <typename ElemTy>
+void SharedStack<ElemTy>::map_header() {
+  void* header = mmap(nullptr, header_bytes(), PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+  if (header == MAP_FAILED) {
+    throw std::system_error(errno, std::generic_category(), "mmap");
+  }
+  header_ = static_cast<Header*>(header);
+}
+
+template <typename ElemTy>
+void SharedStack<ElemTy>::init_mutex() {
+  pthread_mutexattr_t attr;
+  int res = pthread_mutexattr_init(&attr);
+  if (res != 0) {
+    throw std::system_error(res, std::generic_category(), "pthread_mutexattr_init");
+  }
+
+  res = pthread_mutexattr_setpshared(&attr, PTHREAD_PROCESS_SHARED);
+  if (res == 0) {
+    res = pthread_mutexattr_setrobust(&attr, PTHREAD_MUTEX_ROBUST);
+  }
+  if (res == 0) {
+    res = pthread_mutex_init(&header_->mutex_, &attr);
+  }
+  pthread_mutexattr_destroy(&attr);
+  if (res != 0) {
+    throw std::system_error(res, std::generic_category(), "pthread_mutex_init");
+  }
+}
+
+template <typename ElemTy>
+void SharedStack<ElemTy>::wait_initialized() {
+  auto deadline = std::chrono::steady_clock::now() + kAttachTimeout;
+  while (object_bytes() < header_bytes()) {
+    wait_step(deadline);
+  }
+  map_header();
+  while (!header_->initialized_.load(std::memory_order_acquire)) {
+    wait_step(deadline);
+  }
+}
+
+template <typename ElemTy>
+void SharedStack<ElemTy>::sync_mapping() {
+  if (data_ != nullptr && mapped_generation_ == header_->generation_) {
+    return;
+  }
+
+  if (data_ != nullptr) {
+    munmap(data_, data_bytes(mapped_capacity_));
+    data_ = nullptr;
+  }
+
+  void* data = mmap(nullptr, data_bytes(header_->capacity_), PROT_READ | PROT_WRITE, MAP_SHARED,
+                    fd_, static_cast<off_t>(header_bytes()));
+  if (data == MAP_FAILED) {
+    throw std::system_error(errno, std::generic_category(), "mmap");
+  }
+  data_ = static_cast<ElemTy*>(data);
+  mapped_capacity_ = header_->capacity_;
+  mapped_generation_ = header_->generation_;
+}
+
+template <typename ElemTy>
+void SharedStack<ElemTy>::grow() {
+  size_t new_capacity = header_->capacity_ * 2;
+  if (ftruncate(fd_, static_cast<off_t>(header_bytes() + data_bytes(new_capacity))) == -1) {
+    throw std::system_error(errno, std::generic_category(), "ftruncate");
+  }
+
+  Mutation mutation{header_};
+  header_->capacity_ = new_capacity;
+  ++header_->generation_;
+}
+
+#endif /* STACK_SHARED_STACK_IMPL_H */
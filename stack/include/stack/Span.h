@@ -0,0 +1,29 @@
+#ifndef STACK_SPAN_H
+#define STACK_SPAN_H
+
+#include <cstddef>
+
+template <typename ElemTy>
+class Span {
+ public:
+  using iterator = ElemTy*;
+
+  Span() = default;
+  Span(ElemTy* data, size_t size);
+
+  ElemTy& operator[](size_t idx) const;
+
+  [[nodiscard]] ElemTy* data() const;
+
+  [[nodiscard]] bool empty() const;
+  [[nodiscard]] size_t size() const;
+
+  [[nodiscard]] iterator begin() const;
+  [[nodiscard]] iterator end() const;
+
+ private:
+  ElemTy* data_{nullptr};
+  size_t size_{0};
+};
+
+#endif /* STACK_SPAN_H */
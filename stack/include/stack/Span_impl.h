@@ -0,0 +1,42 @@
+#ifndef STACK_SPAN_IMPL_H
+#define STACK_SPAN_IMPL_H
+
+#include <cassert>
+
+#include "stack/Span.h"
+
+template <typename ElemTy>
+Span<ElemTy>::Span(ElemTy* data, size_t size) : data_(data), size_(size) {}
+
+template <typename ElemTy>
+ElemTy& Span<ElemTy>::operator[](size_t idx) const {
+  assert(idx < size_);
+  return data_[idx];
+}
+
+template <typename ElemTy>
+ElemTy* Span<ElemTy>::data() const {
+  return data_;
+}
+
+template <typename ElemTy>
+bool Span<ElemTy>::empty() const {
+  return size_ == 0;
+}
+
+template <typename ElemTy>
+size_t Span<ElemTy>::size() const {
+  return size_;
+}
+
+template <typename ElemTy>
+typename Span<ElemTy>::iterator Span<ElemTy>::begin() const {
+  return data_;
+}
+
+template <typename ElemTy>
+typename Span<ElemTy>::iterator Span<ElemTy>::end() const {
+  return data_ + size_;
+}
+
+#endif /* STACK_SPAN_IMPL_H */
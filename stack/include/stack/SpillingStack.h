@@ -0,0 +1,68 @@
+#ifndef STACK_SPILLING_STACK_H
+#define STACK_SPILLING_STACK_H
+
+#include <cstddef>
+#include <deque>
+#include <future>
+#include <type_traits>
+
+#include "stack/Stack.h"
+
+template <typename ElemTy>
+class SpillingStack {
+  static_assert(std::is_trivially_copyable_v<ElemTy>);
+
+ public:
+  static const size_t kDefaultSegmentSize = 1 << 16;
+
+  explicit SpillingStack(size_t memory_budget, size_t segment_size = kDefaultSegmentSize);
+  SpillingStack(const SpillingStack& other) = delete;
+  SpillingStack(SpillingStack&& other) = delete;
+
+  ~SpillingStack();
+
+  SpillingStack& operator=(const SpillingStack& rhs) = delete;
+  SpillingStack& operator=(SpillingStack&& other) = delete;
+
+  ElemTy& top();
+  [[nodiscard]] const ElemTy& top() const;
+
+  [[nodiscard]] bool empty() const;
+  [[nodiscard]] size_t size() const;
+  [[nodiscard]] size_t spilled_segments_cnt() const;
+  [[nodiscard]] size_t buffers_cnt() const;
+
+  void push(ElemTy val);
+  void pop();
+
+ private:
+  size_t segment_size_;
+  size_t max_buffers_;
+  size_t buffers_cnt_{0};
+  size_t size_{0};
+  size_t spilled_{0};
+  int fd_;
+
+  std::deque<ElemTy*> resident_;
+  Stack<ElemTy*> spare_;
+
+  std::future<void> prefetch_;
+  ElemTy* prefetch_buffer_{nullptr};
+  size_t prefetch_segment_{0};
+
+  [[nodiscard]] size_t segment_bytes() const;
+  [[nodiscard]] size_t segment_offset(size_t segment) const;
+
+  ElemTy* acquire_buffer();
+  void release_buffer(ElemTy* buffer);
+
+  void spill();
+  void unspill();
+  void start_prefetch();
+  void cancel_prefetch();
+
+  void write_segment(size_t segment, const ElemTy* buffer) const;
+  void read_segment(size_t segment, ElemTy* buffer) const;
+};
+
+#endif /* STACK_SPILLING_STACK_H */
@@ -0,0 +1,244 @@
+#ifndef STACK_SPILLING_STACK_IMPL_H
+#define STACK_SPILLING_STACK_IMPL_H
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#include "stack/SpillingStack.h"
+#include "stack/Stack_impl.h"
+
+template <typename ElemTy>
+SpillingStack<ElemTy>::SpillingStack(size_t memory_budget, size_t segment_size)
+    : segment_size_(segment_size) {
+  assert(segment_size_ > 0);
+  max_buffers_ = std::max<size_t>(memory_budget / segment_bytes(), 1);
+
+  std::string path = (std::filesystem::temp_directory_path() / "spilling-stack-XXXXXX").string();
+  fd_ = mkstemp(path.data());
+  if (fd_ == -1) {
+    throw std::system_error(errno, std::generic_category(), "mkstemp");
+  }
+  unlink(path.c_str());
+}
+
+template <typename ElemTy>
+SpillingStack<ElemTy>::~SpillingStack() {
+  cancel_prefetch();
+  for (ElemTy* buffer : resident_) {
+    delete[] buffer;
+  }
+  while (!spare_.empty()) {
+    delete[] spare_.top();
+    spare_.pop();
+  }
+  close(fd_);
+}
+
+template <typename ElemTy>
+ElemTy& SpillingStack<ElemTy>::top() {
+  assert(!empty());
+  return resident_.back()[(size_ - 1) % segment_size_];
+}
+
+template <typename ElemTy>
+const ElemTy& SpillingStack<ElemTy>::top() const {
+  assert(!empty());
+  return resident_.back()[(size_ - 1) % segment_size_];
+}
+
+template <typename ElemTy>
+bool SpillingStack<ElemTy>::empty() const {
+  return size_ == 0;
+}
+
+template <typename ElemTy>
+size_t SpillingStack<ElemTy>::size() const {
+  return size_;
+}
+
+template <typename ElemTy>
+size_t SpillingStack<ElemTy>::spilled_segments_cnt() const {
+  return spilled_;
+}
+
+template <typename ElemTy>
+size_t SpillingStack<ElemTy>::buffers_cnt() const {
+  return buffers_cnt_;
+}
+
+template <typename ElemTy>
+void SpillingStack<ElemTy>::push(ElemTy val) {
+  if (size_ % segment_size_ == 0) {
+    if (resident_.size() == max_buffers_) {
+      spill();
+    }
+    resident_.push_back(acquire_buffer());
+  }
+
+  resident_.back()[size_ % segment_size_] = val;
+  ++size_;
+}
+
+template <typename ElemTy>
+void SpillingStack<ElemTy>::pop() {
+  assert(!empty());
+  --size_;
+
+  if (size_ % segment_size_ == 0) {
+    release_buffer(resident_.back());
+    resident_.pop_back();
+    if (resident_.empty() && spilled_ > 0) {
+      unspill();
+    }
+  }
+
+  if (resident_.size() == 1 && spilled_ > 0) {
+    start_prefetch();
+  }
+}
+
+template <typename ElemTy>
+size_t SpillingStack<ElemTy>::segment_bytes() const {
+  return segment_size_ * sizeof(ElemTy);
+}
+
+template <typename ElemTy>
+size_t SpillingStack<ElemTy>::segment_offset(size_t segment) const {
+  return segment * segment_bytes();
+}
+
+template <typename ElemTy>
+ElemTy* SpillingStack<ElemTy>::acquire_buffer() {
+  if (spare_.empty() && buffers_cnt_ == max_buffers_) {
+    cancel_prefetch();
+  }
+  if (spare_.empty()) {
+    assert(buffers_cnt_ < max_buffers_);
+    ++buffers_cnt_;
+    return new ElemTy[segment_size_];
+  }
+
+  ElemTy* buffer = spare_.top();
+  spare_.pop();
+  return buffer;
+}
+
+template <typename ElemTy>
+void SpillingStack<ElemTy>::release_buffer(ElemTy* buffer) {
+  if (!spare_.empty()) {
+    delete[] buffer;
+    --buffers_cnt_;
+    return;
+  }
+  spare_.push(buffer);
+}
+
+template <typename ElemTy>
+void SpillingStack<ElemTy>::spill() {
+  cancel_prefetch();
+
+  ElemTy* buffer = resident_.front();
+  resident_.pop_front();
+  write_segment(spilled_++, buffer);
+  release_buffer(buffer);
+}
+
+template <typename ElemTy>
+void SpillingStack<ElemTy>::unspill() {
+  size_t segment = spilled_ - 1;
+  std::future<void> prefetch;
+  ElemTy* buffer = nullptr;
+  if (prefetch_.valid() && prefetch_segment_ == segment) {
+    prefetch = std::move(prefetch_);
+    buffer = std::exchange(prefetch_buffer_, nullptr);
+  } else {
+    cancel_prefetch();
+    buffer = acquire_buffer();
+  }
+
+  try {
+    if (prefetch.valid()) {
+      prefetch.get();
+    } else {
+      read_segment(segment, buffer);
+    }
+    resident_.push_front(buffer);
+  } catch (...) {
+    release_buffer(buffer);
+    throw;
+  }
+  --spilled_;
+}
+
+template <typename ElemTy>
+void SpillingStack<ElemTy>::start_prefetch() {
+  if (prefetch_.valid() || (spare_.empty() && buffers_cnt_ == max_buffers_)) {
+    return;
+  }
+
+  prefetch_buffer_ = acquire_buffer();
+  prefetch_segment_ = spilled_ - 1;
+  prefetch_ = std::async(std::launch::async, [this, segment = prefetch_segment_,
+                                              buffer = prefetch_buffer_] {
+    read_segment(segment, buffer);
+  });
+}
+
+template <typename ElemTy>
+void SpillingStack<ElemTy>::cancel_prefetch() {
+  if (!prefetch_.valid()) {
+    return;
+  }
+
+  prefetch_.wait();
+  prefetch_ = {};
+  release_buffer(prefetch_buffer_);
+  prefetch_buffer_ = nullptr;
+}
+
+template <typename ElemTy>
+void SpillingStack<ElemTy>::write_segment(size_t segment, const ElemTy* buffer) const {
+  const auto* bytes = reinterpret_cast<const char*>(buffer);
+  size_t bytes_written = 0;
+  while (bytes_written < segment_bytes()) {
+    ssize_t res = pwrite(fd_, bytes + bytes_written, segment_bytes() - bytes_written,
+                         static_cast<off_t>(segment_offset(segment) + bytes_written));
+    if (res == -1) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw std::system_error(errno, std::generic_category(), "pwrite");
+    }
+    bytes_written += res;
+  }
+}
+
+template <typename ElemTy>
+void SpillingStack<ElemTy>::read_segment(size_t segment, ElemTy* buffer) const {
+  auto* bytes = reinterpret_cast<char*>(buffer);
+  size_t bytes_read = 0;
+  while (bytes_read < segment_bytes()) {
+    ssize_t res = pread(fd_, bytes + bytes_read, segment_bytes() - bytes_read,
+                        static_cast<off_t>(segment_offset(segment) + bytes_read));
+    if (res == -1) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw std::system_error(errno, std::generic_category(), "pread");
+    }
+    if (res == 0) {
+      throw std::system_error(EIO, std::generic_category(), "pread");
+    }
+    bytes_read += res;
+  }
+}
+
+#endif /* STACK_SPILLING_STACK_IMPL_H */
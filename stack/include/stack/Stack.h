@@ -3,10 +3,26 @@
 
 #include <climits>
 #include <cstddef>
+#include <functional>
+#include <iterator>
+#include <optional>
+#include <type_traits>
 
-template <typename ElemTy>
-class Stack {
+#include "stack/Span.h"
+#include "stack/StackStorage.h"
+#include "stack/StackTraceOp.h"
+
+template <typename ElemTy, bool CopyOnWrite = false, bool Hashed = false>
+class Stack : private CopyOnWriteStorage<CopyOnWrite>, private HashedStorage<Hashed> {
  public:
+  using element_type = std::conditional_t<Hashed, const ElemTy, ElemTy>;
+  using reference = element_type&;
+  using pointer = element_type*;
+  using iterator = pointer;
+  using const_iterator = const ElemTy*;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
   explicit Stack(float grow_coeff = 1.5);
   Stack(const ElemTy* other_datum, size_t other_size, float grow_coeff = 1.5);
   Stack(const Stack& other);
@@ -27,29 +43,136 @@ class Stack {
 
   void swap(Stack& other);
 
-  ElemTy& top();
+  reference top();
   [[nodiscard]] const ElemTy& top() const;
 
+  pointer data();
+  [[nodiscard]] const ElemTy* data() const;
+
+  Span<element_type> span();
+  [[nodiscard]] Span<const ElemTy> span() const;
+
+  iterator begin();
+  [[nodiscard]] const_iterator begin() const;
+  iterator end();
+  [[nodiscard]] const_iterator end() const;
+
+  reverse_iterator rbegin();
+  [[nodiscard]] const_reverse_iterator rbegin() const;
+  reverse_iterator rend();
+  [[nodiscard]] const_reverse_iterator rend() const;
+
   [[nodiscard]] bool empty() const;
   [[nodiscard]] size_t size() const;
 
+  void reserve(size_t capacity);
+
+  [[nodiscard]] size_t hash() const;
+
+  [[nodiscard]] bool contains(const ElemTy& val) const;
+  [[nodiscard]] std::optional<size_t> depth_of(const ElemTy& val) const;
+  [[nodiscard]] size_t count(const ElemTy& val) const;
+
   void push(ElemTy val);
   void pop();
 
  private:
+  friend class ParallelStack;
+
   static const size_t kDefaultCapacity = 32;
+  static const size_t kUnshareable = 0;
 
   ElemTy* data_;
   size_t size_{0};
   size_t capacity_;
   float grow_coeff_;
 
+  static size_t element_hash(const ElemTy& val);
+
+  void trace(StackTraceOp op, size_t arg) const;
+
   void grow();
+
+  [[nodiscard]] bool shareable() const;
+  void make_unshareable();
+  void clone_buffer();
+
+  void detach();
+  void reallocate(size_t new_capacity);
+  void release();
 };
 
-template <>
-class Stack<bool> {
+template <bool CopyOnWrite, bool Hashed>
+class Stack<bool, CopyOnWrite, Hashed> : private CopyOnWriteStorage<CopyOnWrite>,
+                                         private HashedStorage<Hashed> {
  public:
+  class BitIterator {
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = bool;
+    using difference_type = ptrdiff_t;
+    using pointer = void;
+    using reference = bool;
+
+    BitIterator() = default;
+    BitIterator(const size_t* chunks, size_t idx);
+
+    bool operator*() const;
+
+    BitIterator& operator++();
+    BitIterator operator++(int);
+    BitIterator& operator--();
+    BitIterator operator--(int);
+
+    bool operator==(const BitIterator& rhs) const;
+    bool operator!=(const BitIterator& rhs) const;
+
+   private:
+    const size_t* chunks_{nullptr};
+    size_t idx_{0};
+  };
+
+  class SetBitIterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = size_t;
+    using difference_type = ptrdiff_t;
+    using pointer = void;
+    using reference = size_t;
+
+    SetBitIterator() = default;
+    SetBitIterator(const Stack* stack, size_t word_idx);
+
+    size_t operator*() const;
+
+    SetBitIterator& operator++();
+    SetBitIterator operator++(int);
+
+    bool operator==(const SetBitIterator& rhs) const;
+    bool operator!=(const SetBitIterator& rhs) const;
+
+   private:
+    const Stack* stack_{nullptr};
+    size_t word_idx_{0};
+    size_t word_{0};
+
+    void skip_empty_words();
+  };
+
+  class SetBitRange {
+   public:
+    explicit SetBitRange(const Stack* stack);
+
+    [[nodiscard]] SetBitIterator begin() const;
+    [[nodiscard]] SetBitIterator end() const;
+
+   private:
+    const Stack* stack_;
+  };
+
+  using const_iterator = BitIterator;
+  using const_reverse_iterator = std::reverse_iterator<BitIterator>;
+
   explicit Stack(float grow_coeff = 1.5);
   Stack(const Stack& other);
   Stack(Stack&& other) noexcept;
@@ -72,9 +195,26 @@ class Stack<bool> {
   [[nodiscard]] bool get_top() const;
   void set_top(bool val);
 
+  [[nodiscard]] const_iterator begin() const;
+  [[nodiscard]] const_iterator end() const;
+
+  [[nodiscard]] const_reverse_iterator rbegin() const;
+  [[nodiscard]] const_reverse_iterator rend() const;
+
+  [[nodiscard]] size_t words_cnt() const;
+  [[nodiscard]] size_t word(size_t idx) const;
+
+  [[nodiscard]] SetBitRange set_bits() const;
+
   [[nodiscard]] bool empty() const;
   [[nodiscard]] size_t size() const;
 
+  [[nodiscard]] size_t hash() const;
+
+  [[nodiscard]] bool contains(bool val) const;
+  [[nodiscard]] std::optional<size_t> depth_of(bool val) const;
+  [[nodiscard]] size_t count(bool val) const;
+
   void push(bool val);
   void pop();
 
@@ -87,13 +227,33 @@ class Stack<bool> {
   size_t chunks_cnt_;
   float grow_coeff_;
 
+  static size_t element_hash(bool val);
+
   [[nodiscard]] size_t chunks_filled() const;
   [[nodiscard]] size_t bits_in_last_chunk() const;
+  [[nodiscard]] size_t top_chunk() const;
   [[nodiscard]] size_t top_bit_mask() const;
 
   [[nodiscard]] size_t chunks_not_empty() const;
 
+  void write_top(bool val);
+
+  void trace(StackTraceOp op, size_t arg) const;
+
   void grow();
+
+  void detach();
+  void reallocate(size_t new_chunks_cnt);
+  void release();
 };
 
+namespace std {
+
+template <typename ElemTy, bool CopyOnWrite, bool Hashed>
+struct hash<Stack<ElemTy, CopyOnWrite, Hashed>> {
+  size_t operator()(const Stack<ElemTy, CopyOnWrite, Hashed>& stack) const;
+};
+
+}  // namespace std
+
 #endif /* STACK_STACK_H */
@@ -0,0 +1,122 @@
+#ifndef STACK_STACK_ARENA_H
+#define STACK_STACK_ARENA_H
+
+#include <cstddef>
+
+template <typename ArenaTy>
+class StackHandle {
+ public:
+  using ValueTy = typename ArenaTy::ValueTy;
+
+  StackHandle(ArenaTy* arena, size_t idx);
+
+  ValueTy& top();
+  [[nodiscard]] const ValueTy& top() const;
+
+  [[nodiscard]] bool empty() const;
+  [[nodiscard]] size_t size() const;
+
+  void push(ValueTy val);
+  void pop();
+
+ private:
+  ArenaTy* arena_;
+  size_t idx_;
+};
+
+template <typename ElemTy>
+class TwoStackArena {
+ public:
+  using ValueTy = ElemTy;
+  using Handle = StackHandle<TwoStackArena>;
+
+  static const size_t kLower = 0;
+  static const size_t kUpper = 1;
+
+  explicit TwoStackArena(float grow_coeff = 1.5);
+  TwoStackArena(const TwoStackArena& other) = delete;
+  TwoStackArena(TwoStackArena&& other) = delete;
+
+  ~TwoStackArena();
+
+  TwoStackArena& operator=(const TwoStackArena& rhs) = delete;
+  TwoStackArena& operator=(TwoStackArena&& other) = delete;
+
+  Handle stack(size_t idx);
+
+  [[nodiscard]] size_t capacity() const;
+
+  ElemTy& top(size_t idx);
+  [[nodiscard]] const ElemTy& top(size_t idx) const;
+
+  [[nodiscard]] bool empty(size_t idx) const;
+  [[nodiscard]] size_t size(size_t idx) const;
+
+  void push(size_t idx, ElemTy val);
+  void pop(size_t idx);
+
+ private:
+  static const size_t kDefaultCapacity = 32;
+
+  ElemTy* data_;
+  size_t capacity_;
+  size_t lower_size_{0};
+  size_t upper_size_{0};
+  float grow_coeff_;
+
+  void grow();
+};
+
+template <typename ElemTy>
+class StackArena {
+ public:
+  using ValueTy = ElemTy;
+  using Handle = StackHandle<StackArena>;
+
+  explicit StackArena(size_t stacks_cnt, float grow_coeff = 1.5);
+  StackArena(const StackArena& other) = delete;
+  StackArena(StackArena&& other) = delete;
+
+  ~StackArena();
+
+  StackArena& operator=(const StackArena& rhs) = delete;
+  StackArena& operator=(StackArena&& other) = delete;
+
+  Handle stack(size_t idx);
+
+  [[nodiscard]] size_t stacks_cnt() const;
+  [[nodiscard]] size_t capacity() const;
+
+  ElemTy& top(size_t idx);
+  [[nodiscard]] const ElemTy& top(size_t idx) const;
+
+  [[nodiscard]] bool empty(size_t idx) const;
+  [[nodiscard]] size_t size(size_t idx) const;
+
+  void push(size_t idx, ElemTy val);
+  void pop(size_t idx);
+
+  void compact();
+
+ private:
+  static const size_t kDefaultSegmentCapacity = 4;
+
+  struct Segment {
+    size_t offset_{0};
+    size_t size_{0};
+    size_t capacity_{0};
+  };
+
+  Segment* segments_;
+  size_t stacks_cnt_;
+  ElemTy* data_;
+  size_t capacity_;
+  size_t used_{0};
+  size_t reserved_{0};
+  float grow_coeff_;
+
+  void grow_segment(size_t idx);
+  void relocate(size_t new_capacity);
+};
+
+#endif /* STACK_STACK_ARENA_H */
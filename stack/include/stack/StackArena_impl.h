@@ -0,0 +1,246 @@
+#ifndef STACK_STACK_ARENA_IMPL_H
+#define STACK_STACK_ARENA_IMPL_H
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+#include "stack/StackArena.h"
+
+template <typename ArenaTy>
+StackHandle<ArenaTy>::StackHandle(ArenaTy* arena, size_t idx) : arena_(arena), idx_(idx) {}
+
+template <typename ArenaTy>
+typename StackHandle<ArenaTy>::ValueTy& StackHandle<ArenaTy>::top() {
+  return arena_->top(idx_);
+}
+
+template <typename ArenaTy>
+const typename StackHandle<ArenaTy>::ValueTy& StackHandle<ArenaTy>::top() const {
+  return std::as_const(*arena_).top(idx_);
+}
+
+template <typename ArenaTy>
+bool StackHandle<ArenaTy>::empty() const {
+  return arena_->empty(idx_);
+}
+
+template <typename ArenaTy>
+size_t StackHandle<ArenaTy>::size() const {
+  return arena_->size(idx_);
+}
+
+template <typename ArenaTy>
+void StackHandle<ArenaTy>::push(ValueTy val) {
+  arena_->push(idx_, std::move(val));
+}
+
+template <typename ArenaTy>
+void StackHandle<ArenaTy>::pop() {
+  arena_->pop(idx_);
+}
+
+template <typename ElemTy>
+TwoStackArena<ElemTy>::TwoStackArena(float grow_coeff)
+    : capacity_(kDefaultCapacity), grow_coeff_(grow_coeff) {
+  data_ = new ElemTy[capacity_];
+}
+
+template <typename ElemTy>
+TwoStackArena<ElemTy>::~TwoStackArena() {
+  delete[] data_;
+}
+
+template <typename ElemTy>
+typename TwoStackArena<ElemTy>::Handle TwoStackArena<ElemTy>::stack(size_t idx) {
+  assert(idx == kLower || idx == kUpper);
+  return Handle{this, idx};
+}
+
+template <typename ElemTy>
+size_t TwoStackArena<ElemTy>::capacity() const {
+  return capacity_;
+}
+
+template <typename ElemTy>
+ElemTy& TwoStackArena<ElemTy>::top(size_t idx) {
+  assert(!empty(idx));
+  return idx == kLower ? data_[lower_size_ - 1] : data_[capacity_ - upper_size_];
+}
+
+template <typename ElemTy>
+const ElemTy& TwoStackArena<ElemTy>::top(size_t idx) const {
+  assert(!empty(idx));
+  return idx == kLower ? data_[lower_size_ - 1] : data_[capacity_ - upper_size_];
+}
+
+template <typename ElemTy>
+bool TwoStackArena<ElemTy>::empty(size_t idx) const {
+  return size(idx) == 0;
+}
+
+template <typename ElemTy>
+size_t TwoStackArena<ElemTy>::size(size_t idx) const {
+  return idx == kLower ? lower_size_ : upper_size_;
+}
+
+template <typename ElemTy>
+void TwoStackArena<ElemTy>::push(size_t idx, ElemTy val) {
+  if (lower_size_ + upper_size_ == capacity_) {
+    grow();
+  }
+
+  if (idx == kLower) {
+    data_[lower_size_++] = std::move(val);
+  } else {
+    data_[capacity_ - ++upper_size_] = std::move(val);
+  }
+}
+
+template <typename ElemTy>
+void TwoStackArena<ElemTy>::pop(size_t idx) {
+  assert(!empty(idx));
+  if (idx == kLower) {
+    --lower_size_;
+  } else {
+    --upper_size_;
+  }
+}
+
+template <typename ElemTy>
+void TwoStackArena<ElemTy>::grow() {
+  size_t new_capacity = capacity_ * grow_coeff_ + 1;
+  auto* new_datum = new ElemTy[new_capacity];
+  std::move(data_, data_ + lower_size_, new_datum);
+  std::move(data_ + capacity_ - upper_size_, data_ + capacity_, new_datum + new_capacity - upper_size_);
+  delete[] data_;
+  data_ = new_datum;
+  capacity_ = new_capacity;
+}
+
+template <typename ElemTy>
+StackArena<ElemTy>::StackArena(size_t stacks_cnt, float grow_coeff)
+    : stacks_cnt_(stacks_cnt),
+      capacity_(stacks_cnt * kDefaultSegmentCapacity),
+      grow_coeff_(grow_coeff) {
+  segments_ = new Segment[stacks_cnt_];
+  data_ = new ElemTy[capacity_];
+}
+
+template <typename ElemTy>
+StackArena<ElemTy>::~StackArena() {
+  delete[] data_;
+  delete[] segments_;
+}
+
+template <typename ElemTy>
+typename StackArena<ElemTy>::Handle StackArena<ElemTy>::stack(size_t idx) {
+  assert(idx < stacks_cnt_);
+  return Handle{this, idx};
+}
+
+template <typename ElemTy>
+size_t StackArena<ElemTy>::stacks_cnt() const {
+  return stacks_cnt_;
+}
+
+template <typename ElemTy>
+size_t StackArena<ElemTy>::capacity() const {
+  return capacity_;
+}
+
+template <typename ElemTy>
+ElemTy& StackArena<ElemTy>::top(size_t idx) {
+  assert(!empty(idx));
+  const Segment& segment = segments_[idx];
+  return data_[segment.offset_ + segment.size_ - 1];
+}
+
+template <typename ElemTy>
+const ElemTy& StackArena<ElemTy>::top(size_t idx) const {
+  assert(!empty(idx));
+  const Segment& segment = segments_[idx];
+  return data_[segment.offset_ + segment.size_ - 1];
+}
+
+template <typename ElemTy>
+bool StackArena<ElemTy>::empty(size_t idx) const {
+  return segments_[idx].size_ == 0;
+}
+
+template <typename ElemTy>
+size_t StackArena<ElemTy>::size(size_t idx) const {
+  return segments_[idx].size_;
+}
+
+template <typename ElemTy>
+void StackArena<ElemTy>::push(size_t idx, ElemTy val) {
+  if (segments_[idx].size_ == segments_[idx].capacity_) {
+    grow_segment(idx);
+  }
+
+  Segment& segment = segments_[idx];
+  data_[segment.offset_ + segment.size_++] = std::move(val);
+}
+
+template <typename ElemTy>
+void StackArena<ElemTy>::pop(size_t idx) {
+  assert(!empty(idx));
+  --segments_[idx].size_;
+}
+
+template <typename ElemTy>
+void StackArena<ElemTy>::compact() {
+  reserved_ = 0;
+  for (size_t i = 0; i < stacks_cnt_; ++i) {
+    segments_[i].capacity_ = segments_[i].size_;
+    reserved_ += segments_[i].size_;
+  }
+  relocate(reserved_);
+}
+
+template <typename ElemTy>
+void StackArena<ElemTy>::grow_segment(size_t idx) {
+  Segment& segment = segments_[idx];
+  size_t new_capacity = segment.capacity_ * grow_coeff_ + 1;
+  if (new_capacity < kDefaultSegmentCapacity) {
+    new_capacity = kDefaultSegmentCapacity;
+  }
+
+  if (segment.offset_ + segment.capacity_ == used_ && segment.offset_ + new_capacity <= capacity_) {
+    reserved_ += new_capacity - segment.capacity_;
+    segment.capacity_ = new_capacity;
+    used_ = segment.offset_ + new_capacity;
+    return;
+  }
+
+  if (used_ + new_capacity > capacity_) {
+    relocate((reserved_ + new_capacity) * grow_coeff_ + 1);
+  }
+
+  std::move(data_ + segment.offset_, data_ + segment.offset_ + segment.size_, data_ + used_);
+  reserved_ += new_capacity - segment.capacity_;
+  segment.offset_ = used_;
+  segment.capacity_ = new_capacity;
+  used_ += new_capacity;
+}
+
+template <typename ElemTy>
+void StackArena<ElemTy>::relocate(size_t new_capacity) {
+  auto* new_datum = new ElemTy[new_capacity];
+
+  size_t offset = 0;
+  for (size_t i = 0; i < stacks_cnt_; ++i) {
+    Segment& segment = segments_[i];
+    std::move(data_ + segment.offset_, data_ + segment.offset_ + segment.size_, new_datum + offset);
+    segment.offset_ = offset;
+    offset += segment.capacity_;
+  }
+
+  delete[] data_;
+  data_ = new_datum;
+  capacity_ = new_capacity;
+  used_ = offset;
+}
+
+#endif /* STACK_STACK_ARENA_IMPL_H */
@@ -0,0 +1,25 @@
+#ifndef STACK_STACK_STORAGE_H
+#define STACK_STACK_STORAGE_H
+
+#include <atomic>
+#include <cstddef>
+
+#include "stack/RollingHash.h"
+
+template <bool CopyOnWrite>
+struct CopyOnWriteStorage {};
+
+template <>
+struct CopyOnWriteStorage<true> {
+  std::atomic<size_t>* ref_cnt_{nullptr};
+};
+
+template <bool Hashed>
+struct HashedStorage {};
+
+template <>
+struct HashedStorage<true> {
+  RollingHash hash_;
+};
+
+#endif /* STACK_STACK_STORAGE_H */
@@ -0,0 +1,15 @@
+#ifndef STACK_STACK_TRACE_OP_H
+#define STACK_STACK_TRACE_OP_H
+
+#include <cstdint>
+
+enum class StackTraceOp : uint8_t {
+  kCreate,
+  kDestroy,
+  kPush,
+  kPop,
+  kGrow,
+  kMovedFrom,
+};
+
+#endif /* STACK_STACK_TRACE_OP_H */
@@ -0,0 +1,98 @@
+#ifndef STACK_STACK_TRACER_H
+#define STACK_STACK_TRACER_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "stack/StackTraceOp.h"
+
+class StackTracer {
+ public:
+  using Op = StackTraceOp;
+
+  struct Record {
+    uint64_t stack_;
+    uint32_t arg_;
+    uint16_t elem_size_;
+    Op op_;
+    uint8_t reserved_;
+  };
+
+  static const size_t kBufferSize = 1 << 12;
+  static const uint32_t kVersion = 1;
+
+  StackTracer(const StackTracer& other) = delete;
+  StackTracer(StackTracer&& other) = delete;
+
+  StackTracer& operator=(const StackTracer& rhs) = delete;
+  StackTracer& operator=(StackTracer&& other) = delete;
+
+  static StackTracer& instance();
+
+  static std::vector<Record> read(const std::string& path);
+
+  void start(const std::string& path);
+  void stop();
+
+  [[nodiscard]] bool active() const;
+
+  void record(const void* stack, Op op, size_t elem_size, size_t arg);
+
+ private:
+  static constexpr std::chrono::milliseconds kIdleWaitTimeout{100};
+  static constexpr char kMagic[8] = {'S', 'T', 'K', 'T', 'R', 'A', 'C', 'E'};
+
+  struct Header {
+    char magic_[sizeof(kMagic)];
+    uint32_t version_;
+    uint32_t record_size_;
+  };
+
+  class ThreadBuffer {
+   public:
+    explicit ThreadBuffer(StackTracer* tracer);
+    ThreadBuffer(const ThreadBuffer& other) = delete;
+    ThreadBuffer(ThreadBuffer&& other) = delete;
+
+    ~ThreadBuffer();
+
+    ThreadBuffer& operator=(const ThreadBuffer& rhs) = delete;
+    ThreadBuffer& operator=(ThreadBuffer&& other) = delete;
+
+    std::mutex mutex_;
+    std::vector<Record> records_;
+
+   private:
+    StackTracer* tracer_;
+  };
+
+  std::atomic<bool> active_{false};
+  int fd_{-1};
+
+  std::mutex buffers_mutex_;
+  std::vector<ThreadBuffer*> buffers_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<std::vector<Record>> pending_;
+  std::thread flusher_;
+  bool stopping_{false};
+
+  StackTracer() = default;
+
+  ThreadBuffer& thread_buffer();
+  void submit(std::vector<Record>& records);
+
+  void flush();
+  void write_bytes(const void* bytes, size_t size);
+};
+
+#endif /* STACK_STACK_TRACER_H */
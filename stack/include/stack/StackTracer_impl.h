@@ -0,0 +1,193 @@
+#ifndef STACK_STACK_TRACER_IMPL_H
+#define STACK_STACK_TRACER_IMPL_H
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+
+#include "stack/StackTracer.h"
+
+inline StackTracer::ThreadBuffer::ThreadBuffer(StackTracer* tracer) : tracer_(tracer) {
+  records_.reserve(kBufferSize);
+
+  std::lock_guard lock{tracer_->buffers_mutex_};
+  tracer_->buffers_.push_back(this);
+}
+
+inline StackTracer::ThreadBuffer::~ThreadBuffer() {
+  std::lock_guard buffers_lock{tracer_->buffers_mutex_};
+  {
+    std::lock_guard records_lock{mutex_};
+    if (!records_.empty()) {
+      tracer_->submit(records_);
+    }
+  }
+  auto& buffers = tracer_->buffers_;
+  buffers.erase(std::find(buffers.begin(), buffers.end(), this));
+}
+
+inline StackTracer& StackTracer::instance() {
+  static auto* tracer = [] {
+    auto* created = new StackTracer;
+    std::atexit([] { instance().stop(); });
+    return created;
+  }();
+  return *tracer;
+}
+
+inline std::vector<StackTracer::Record> StackTracer::read(const std::string& path) {
+  std::ifstream file{path, std::ios::binary | std::ios::ate};
+  if (!file) {
+    throw std::system_error(errno, std::generic_category(), "open " + path);
+  }
+  auto file_size = static_cast<size_t>(file.tellg());
+  file.seekg(0);
+
+  Header header{};
+  if (file_size < sizeof(header) ||
+      !file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+      std::memcmp(header.magic_, kMagic, sizeof(kMagic)) != 0 || header.version_ != kVersion ||
+      header.record_size_ != sizeof(Record)) {
+    throw std::runtime_error(path + " is not a stack trace");
+  }
+
+  std::vector<Record> records((file_size - sizeof(header)) / sizeof(Record));
+  file.read(reinterpret_cast<char*>(records.data()),
+            static_cast<std::streamsize>(records.size() * sizeof(Record)));
+  return records;
+}
+
+inline void StackTracer::start(const std::string& path) {
+  assert(!active());
+  fd_ = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd_ == -1) {
+    throw std::system_error(errno, std::generic_category(), "open " + path);
+  }
+
+  Header header{};
+  std::memcpy(header.magic_, kMagic, sizeof(kMagic));
+  header.version_ = kVersion;
+  header.record_size_ = sizeof(Record);
+  write_bytes(&header, sizeof(header));
+
+  stopping_ = false;
+  flusher_ = std::thread([this] { flush(); });
+  active_.store(true, std::memory_order_release);
+}
+
+inline void StackTracer::stop() {
+  if (!active_.exchange(false)) {
+    return;
+  }
+
+  {
+    std::lock_guard buffers_lock{buffers_mutex_};
+    for (ThreadBuffer* buffer : buffers_) {
+      std::lock_guard records_lock{buffer->mutex_};
+      if (!buffer->records_.empty()) {
+        submit(buffer->records_);
+      }
+    }
+  }
+  {
+    std::lock_guard lock{mutex_};
+    stopping_ = true;
+  }
+  cv_.notify_all();
+  flusher_.join();
+
+  close(fd_);
+  fd_ = -1;
+}
+
+inline bool StackTracer::active() const {
+  return active_.load(std::memory_order_relaxed);
+}
+
+inline void StackTracer::record(const void* stack, Op op, size_t elem_size, size_t arg) {
+  if (!active()) {
+    return;
+  }
+
+  ThreadBuffer& buffer = thread_buffer();
+  std::lock_guard lock{buffer.mutex_};
+  if (!active()) {
+    return;
+  }
+
+  std::vector<Record>& records = buffer.records_;
+  records.push_back(Record{reinterpret_cast<uintptr_t>(stack),
+                           static_cast<uint32_t>(std::min<size_t>(arg, UINT32_MAX)),
+                           static_cast<uint16_t>(std::min<size_t>(elem_size, UINT16_MAX)),
+                           op,
+                           0});
+  if (records.size() >= kBufferSize) {
+    submit(records);
+  }
+}
+
+inline StackTracer::ThreadBuffer& StackTracer::thread_buffer() {
+  thread_local ThreadBuffer buffer{this};
+  return buffer;
+}
+
+inline void StackTracer::submit(std::vector<Record>& records) {
+  std::vector<Record> full;
+  full.reserve(kBufferSize);
+  full.swap(records);
+  {
+    std::lock_guard lock{mutex_};
+    pending_.push_back(std::move(full));
+  }
+  cv_.notify_all();
+}
+
+inline void StackTracer::flush() {
+  bool failed = false;
+  std::unique_lock lock{mutex_};
+  while (true) {
+    while (!pending_.empty()) {
+      std::vector<Record> records = std::move(pending_.front());
+      pending_.pop_front();
+      lock.unlock();
+      try {
+        if (!failed) {
+          write_bytes(records.data(), records.size() * sizeof(Record));
+        }
+      } catch (const std::system_error&) {
+        failed = true;
+      }
+      lock.lock();
+    }
+    if (stopping_) {
+      return;
+    }
+    cv_.wait_for(lock, kIdleWaitTimeout);
+  }
+}
+
+inline void StackTracer::write_bytes(const void* bytes, size_t size) {
+  const auto* src = static_cast<const char*>(bytes);
+  while (size > 0) {
+    ssize_t res = write(fd_, src, size);
+    if (res == -1) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw std::system_error(errno, std::generic_category(), "write");
+    }
+    src += res;
+    size -= res;
+  }
+}
+
+#endif /* STACK_STACK_TRACER_IMPL_H */
@@ -7,46 +7,123 @@
 #include <cstring>
 #include <utility>
 
+#include "stack/ElementSearch_impl.h"
+#include "stack/RollingHash_impl.h"
+#include "stack/Span_impl.h"
 #include "stack/Stack.h"
 
-template <typename ElemTy>
-Stack<ElemTy>::Stack(float grow_coeff) : capacity_(kDefaultCapacity), grow_coeff_(grow_coeff) {
+#ifdef STACK_TRACE
+#include "stack/StackTracer_impl.h"
+#endif
+
+template <typename ElemTy, bool CopyOnWrite, bool Hashed>
+Stack<ElemTy, CopyOnWrite, Hashed>::Stack(float grow_coeff)
+    : capacity_(kDefaultCapacity), grow_coeff_(grow_coeff) {
   data_ = new ElemTy[capacity_];
+  if constexpr (CopyOnWrite) {
+    this->ref_cnt_ = new std::atomic<size_t>{1};
+  }
+  trace(StackTraceOp::kCreate, size_);
 }
 
-template <typename ElemTy>
-Stack<ElemTy>::Stack(const ElemTy* other_datum, size_t other_size, float grow_coeff) // NOLINT(bugprone-easily-swappable-parameters)
+template <typename ElemTy, bool CopyOnWrite, bool Hashed>
+Stack<ElemTy, CopyOnWrite, Hashed>::Stack(const ElemTy* other_datum, size_t other_size, float grow_coeff) // NOLINT(bugprone-easily-swappable-parameters)
     : size_(other_size), capacity_(other_size), grow_coeff_(grow_coeff) {
   data_ = new ElemTy[capacity_];
   std::copy(other_datum, other_datum + size_, data_);
+  if constexpr (CopyOnWrite) {
+    this->ref_cnt_ = new std::atomic<size_t>{1};
+  }
+  if constexpr (Hashed) {
+    for (size_t i = 0; i < size_; ++i) {
+      this->hash_.push(element_hash(data_[i]));
+    }
+  }
+  trace(StackTraceOp::kCreate, size_);
 }
 
-template <typename ElemTy>
-Stack<ElemTy>::Stack(const Stack& other) : Stack(other.data_, other.size_, other.grow_coeff_) {}
+template <typename ElemTy, bool CopyOnWrite, bool Hashed>
+Stack<ElemTy, CopyOnWrite, Hashed>::Stack(const Stack& other)
+    : CopyOnWriteStorage<CopyOnWrite>(other),
+      HashedStorage<Hashed>(other),
+      data_(other.data_),
+      size_(other.size_),
+      capacity_(other.capacity_),
+      grow_coeff_(other.grow_coeff_) {
+  if constexpr (CopyOnWrite) {
+    if (!other.shareable()) {
+      clone_buffer();
+    } else if (this->ref_cnt_ != nullptr) {
+      this->ref_cnt_->fetch_add(1, std::memory_order_relaxed);
+    }
+  } else {
+    capacity_ = size_;
+    data_ = new ElemTy[capacity_];
+    std::copy(other.data_, other.data_ + size_, data_);
+  }
+  trace(StackTraceOp::kCreate, size_);
+}
 
-template <typename ElemTy>
-Stack<ElemTy>::Stack(Stack&& other) noexcept
-    : data_(other.data_),
+template <typename ElemTy, bool CopyOnWrite, bool Hashed>
+Stack<ElemTy, CopyOnWrite, Hashed>::Stack(Stack&& other) noexcept
+    : CopyOnWriteStorage<CopyOnWrite>(other),
+      HashedStorage<Hashed>(other),
+      data_(other.data_),
       size_(other.size_),
       capacity_(other.capacity_),
       grow_coeff_(other.grow_coeff_) {
   other.data_ = nullptr;
   other.capacity_ = other.size_ = 0;
+  if constexpr (CopyOnWrite) {
+    other.ref_cnt_ = nullptr;
+  }
+  if constexpr (Hashed) {
+    other.hash_ = {};
+  }
+  trace(StackTraceOp::kCreate, size_);
+  other.trace(StackTraceOp::kMovedFrom, 0);
 }
 
-template <typename ElemTy>
-Stack<ElemTy>::~Stack() {
-  delete[] data_;
+template <typename ElemTy, bool CopyOnWrite, bool Hashed>
+Stack<ElemTy, CopyOnWrite, Hashed>::~Stack() {
+  trace(StackTraceOp::kDestroy, 0);
+  release();
 }
 
-template <typename ElemTy>
-Stack<ElemTy>& Stack<ElemTy>::operator=(const Stack& rhs) {
+template <typename ElemTy, bool CopyOnWrite, bool Hashed>
+Stack<ElemTy, CopyOnWrite, Hashed>&
+Stack<ElemTy, CopyOnWrite, Hashed>::operator=(const Stack& rhs) {
   if (this == &rhs) {
     return *this;
   }
 
+  if constexpr (CopyOnWrite) {
+    bool rhs_shareable = rhs.shareable();
+    if (rhs_shareable && rhs.ref_cnt_ != nullptr) {
+      rhs.ref_cnt_->fetch_add(1, std::memory_order_relaxed);
+    }
+    release();
+
+    data_ = rhs.data_;
+    size_ = rhs.size_;
+    capacity_ = rhs.capacity_;
+    grow_coeff_ = rhs.grow_coeff_;
+    this->ref_cnt_ = rhs.ref_cnt_;
+    if constexpr (Hashed) {
+      this->hash_ = rhs.hash_;
+    }
+    if (!rhs_shareable) {
+      clone_buffer();
+    }
+    trace(StackTraceOp::kCreate, size_);
+    return *this;
+  }
+
   size_ = rhs.size_;
   grow_coeff_ = rhs.grow_coeff_;
+  if constexpr (Hashed) {
+    this->hash_ = rhs.hash_;
+  }
   size_t old_cap = capacity_;
   capacity_ = rhs.capacity_;
   if (old_cap < capacity_) {
@@ -55,33 +132,54 @@ Stack<ElemTy>& Stack<ElemTy>::operator=(const Stack& rhs) {
     data_ = new ElemTy[capacity_];
   }
   std::copy(rhs.data_, rhs.data_ + size_, data_);
+  trace(StackTraceOp::kCreate, size_);
   return *this;
 }
 
-template <typename ElemTy>
-Stack<ElemTy>& Stack<ElemTy>::operator=(Stack&& other) noexcept {
+template <typename ElemTy, bool CopyOnWrite, bool Hashed>
+Stack<ElemTy, CopyOnWrite, Hashed>&
+Stack<ElemTy, CopyOnWrite, Hashed>::operator=(Stack&& other) noexcept {
   if (this == &other) {
     return *this;
   }
 
-  delete[] data_;
+  release();
 
   data_ = other.data_;
   size_ = other.size_;
   capacity_ = other.capacity_;
   grow_coeff_ = other.grow_coeff_;
+  if constexpr (CopyOnWrite) {
+    this->ref_cnt_ = other.ref_cnt_;
+  }
+  if constexpr (Hashed) {
+    this->hash_ = other.hash_;
+  }
 
   other.data_ = nullptr;
   other.capacity_ = other.size_ = 0;
+  if constexpr (CopyOnWrite) {
+    other.ref_cnt_ = nullptr;
+  }
+  if constexpr (Hashed) {
+    other.hash_ = {};
+  }
+  trace(StackTraceOp::kCreate, size_);
+  other.trace(StackTraceOp::kMovedFrom, 0);
 
   return *this;
 }
 
-template <typename ElemTy>
-bool Stack<ElemTy>::operator==(const Stack& rhs) const {
+template <typename ElemTy, bool CopyOnWrite, bool Hashed>
+bool Stack<ElemTy, CopyOnWrite, Hashed>::operator==(const Stack& rhs) const {
   if (size_ != rhs.size_) {
     return false;
   }
+  if constexpr (Hashed) {
+    if (this->hash_ != rhs.hash_) {
+      return false;
+    }
+  }
 
   for (size_t i = 0; i < size_; ++i) {
     if (data_[i] != rhs.data_[i]) {
@@ -91,13 +189,13 @@ bool Stack<ElemTy>::operator==(const Stack& rhs) const {
   return true;
 }
 
-template <typename ElemTy>
-bool Stack<ElemTy>::operator!=(const Stack& rhs) const {
+template <typename ElemTy, bool CopyOnWrite, bool Hashed>
+bool Stack<ElemTy, CopyOnWrite, Hashed>::operator!=(const Stack& rhs) const {
   return !(*this == rhs);
 }
 
-template <typename ElemTy>
-bool Stack<ElemTy>::operator<(const Stack& rhs) const {
+template <typename ElemTy, bool CopyOnWrite, bool Hashed>
+bool Stack<ElemTy, CopyOnWrite, Hashed>::operator<(const Stack& rhs) const {
   for (size_t i = 0, j = 0; i < size_ && j < rhs.size_; ++i, ++j) {
     if (data_[i] >= rhs.data_[j]) {
       return false;
@@ -107,106 +205,489 @@ bool Stack<ElemTy>::operator<(const Stack& rhs) const {
   return size_ <= rhs.size_;
 }
 
-template <typename ElemTy>
-bool Stack<ElemTy>::operator>(const Stack& rhs) const {
+template <typename ElemTy, bool CopyOnWrite, bool Hashed>
+bool Stack<ElemTy, CopyOnWrite, Hashed>::operator>(const Stack& rhs) const {
   return rhs < *this;
 }
 
-template <typename ElemTy>
-bool Stack<ElemTy>::operator<=(const Stack& rhs) const {
+template <typename ElemTy, bool CopyOnWrite, bool Hashed>
+bool Stack<ElemTy, CopyOnWrite, Hashed>::operator<=(const Stack& rhs) const {
   return !(rhs < *this);
 }
 
-template <typename ElemTy>
-bool Stack<ElemTy>::operator>=(const Stack& rhs) const {
+template <typename ElemTy, bool CopyOnWrite, bool Hashed>
+bool Stack<ElemTy, CopyOnWrite, Hashed>::operator>=(const Stack& rhs) const {
   return !(*this < rhs);
 }
 
-template <typename ElemTy>
-ElemTy& Stack<ElemTy>::top() {
+template <typename ElemTy, bool CopyOnWrite, bool Hashed>
+typename Stack<ElemTy, CopyOnWrite, Hashed>::reference Stack<ElemTy, CopyOnWrite, Hashed>::top() {
   assert(!empty());
+  if constexpr (CopyOnWrite && !Hashed) {
+    make_unshareable();
+  }
   return data_[size_ - 1];
 }
 
-template <typename ElemTy>
-const ElemTy& Stack<ElemTy>::top() const {
+template <typename ElemTy, bool CopyOnWrite, bool Hashed>
+const ElemTy& Stack<ElemTy, CopyOnWrite, Hashed>::top() const {
   assert(!empty());
   return data_[size_ - 1];
 }
 
-template <typename ElemTy>
-bool Stack<ElemTy>::empty() const {
+template <typename ElemTy, bool CopyOnWrite, bool Hashed>
+typename Stack<ElemTy, CopyOnWrite, Hashed>::pointer Stack<ElemTy, CopyOnWrite, Hashed>::data() {
+  if constexpr (CopyOnWrite && !Hashed) {
+    make_unshareable();
+  }
+  return data_;
+}
+
+template <typename ElemTy, bool CopyOnWrite, bool Hashed>
+const ElemTy* Stack<ElemTy, CopyOnWrite, Hashed>::data() const {
+  return data_;
+}
+
+template <typename ElemTy, bool CopyOnWrite, bool Hashed>
+Span<typename Stack<ElemTy, CopyOnWrite, Hashed>::element_type>
+Stack<ElemTy, CopyOnWrite, Hashed>::span() {
+  return Span<element_type>{data(), size_};
+}
+
+template <typename ElemTy, bool CopyOnWrite, bool Hashed>
+Span<const ElemTy> Stack<ElemTy, CopyOnWrite, Hashed>::span() const {
+  return Span<const ElemTy>{data_, size_};
+}
+
+template <typename ElemTy, bool CopyOnWrite, bool Hashed>
+typename Stack<ElemTy, CopyOnWrite, Hashed>::iterator Stack<ElemTy, CopyOnWrite, Hashed>::begin() {
+  return data();
+}
+
+template <typename ElemTy, bool CopyOnWrite, bool Hashed>
+typename Stack<ElemTy, CopyOnWrite, Hashed>::const_iterator
+Stack<ElemTy, CopyOnWrite, Hashed>::begin() const {
+  return data_;
+}
+
+template <typename ElemTy, bool CopyOnWrite, bool Hashed>
+typename Stack<ElemTy, CopyOnWrite, Hashed>::iterator Stack<ElemTy, CopyOnWrite, Hashed>::end() {
+  return data() + size_;
+}
+
+template <typename ElemTy, bool CopyOnWrite, bool Hashed>
+typename Stack<ElemTy, CopyOnWrite, Hashed>::const_iterator
+Stack<ElemTy, CopyOnWrite, Hashed>::end() const {
+  return data_ + size_;
+}
+
+template <typename ElemTy, bool CopyOnWrite, bool Hashed>
+typename Stack<ElemTy, CopyOnWrite, Hashed>::reverse_iterator
+Stack<ElemTy, CopyOnWrite, Hashed>::rbegin() {
+  return reverse_iterator{end()};
+}
+
+template <typename ElemTy, bool CopyOnWrite, bool Hashed>
+typename Stack<ElemTy, CopyOnWrite, Hashed>::const_reverse_iterator
+Stack<ElemTy, CopyOnWrite, Hashed>::rbegin() const {
+  return const_reverse_iterator{end()};
+}
+
+template <typename ElemTy, bool CopyOnWrite, bool Hashed>
+typename Stack<ElemTy, CopyOnWrite, Hashed>::reverse_iterator
+Stack<ElemTy, CopyOnWrite, Hashed>::rend() {
+  return reverse_iterator{begin()};
+}
+
+template <typename ElemTy, bool CopyOnWrite, bool Hashed>
+typename Stack<ElemTy, CopyOnWrite, Hashed>::const_reverse_iterator
+Stack<ElemTy, CopyOnWrite, Hashed>::rend() const {
+  return const_reverse_iterator{begin()};
+}
+
+template <typename ElemTy, bool CopyOnWrite, bool Hashed>
+bool Stack<ElemTy, CopyOnWrite, Hashed>::empty() const {
   return size_ == 0;
 }
 
-template <typename ElemTy>
-size_t Stack<ElemTy>::size() const {
+template <typename ElemTy, bool CopyOnWrite, bool Hashed>
+size_t Stack<ElemTy, CopyOnWrite, Hashed>::size() const {
   return size_;
 }
 
-template <typename ElemTy>
-void Stack<ElemTy>::push(ElemTy val) {
-  if (size_ < capacity_) {
-    data_[size_++] = val;
+template <typename ElemTy, bool CopyOnWrite, bool Hashed>
+void Stack<ElemTy, CopyOnWrite, Hashed>::reserve(size_t capacity) {
+  if (capacity <= capacity_) {
     return;
   }
+  reallocate(capacity);
+  trace(StackTraceOp::kGrow, capacity_);
+}
 
-  grow();
-  data_[size_++] = val;
+template <typename ElemTy, bool CopyOnWrite, bool Hashed>
+void Stack<ElemTy, CopyOnWrite, Hashed>::push(ElemTy val) {
+  if (size_ < capacity_) {
+    if constexpr (CopyOnWrite) {
+      detach();
+    }
+  } else {
+    grow();
+  }
+
+  data_[size_] = std::move(val);
+  ++size_;
+  if constexpr (Hashed) {
+    this->hash_.push(element_hash(data_[size_ - 1]));
+  }
+  trace(StackTraceOp::kPush, size_);
 }
 
-template <typename ElemTy>
-void Stack<ElemTy>::pop() {
+template <typename ElemTy, bool CopyOnWrite, bool Hashed>
+void Stack<ElemTy, CopyOnWrite, Hashed>::pop() {
   assert(!empty());
+  if constexpr (Hashed) {
+    this->hash_.pop(element_hash(data_[size_ - 1]));
+  }
   --size_;
+  trace(StackTraceOp::kPop, size_);
+}
+
+template <typename ElemTy, bool CopyOnWrite, bool Hashed>
+size_t Stack<ElemTy, CopyOnWrite, Hashed>::hash() const {
+  if constexpr (Hashed) {
+    return this->hash_.value();
+  }
+
+  RollingHash hash;
+  for (size_t i = 0; i < size_; ++i) {
+    hash.push(element_hash(data_[i]));
+  }
+  return hash.value();
+}
+
+template <typename ElemTy, bool CopyOnWrite, bool Hashed>
+bool Stack<ElemTy, CopyOnWrite, Hashed>::contains(const ElemTy& val) const {
+  return ElementSearch::find_last(data_, size_, val) != size_;
 }
 
-template <typename ElemTy>
-void Stack<ElemTy>::swap(Stack& other) {
+template <typename ElemTy, bool CopyOnWrite, bool Hashed>
+std::optional<size_t> Stack<ElemTy, CopyOnWrite, Hashed>::depth_of(const ElemTy& val) const {
+  size_t idx = ElementSearch::find_last(data_, size_, val);
+  if (idx == size_) {
+    return std::nullopt;
+  }
+  return size_ - 1 - idx;
+}
+
+template <typename ElemTy, bool CopyOnWrite, bool Hashed>
+size_t Stack<ElemTy, CopyOnWrite, Hashed>::count(const ElemTy& val) const {
+  return ElementSearch::count(data_, size_, val);
+}
+
+template <typename ElemTy, bool CopyOnWrite, bool Hashed>
+void Stack<ElemTy, CopyOnWrite, Hashed>::swap(Stack& other) {
   std::swap(data_, other.data_);
   std::swap(size_, other.size_);
   std::swap(capacity_, other.capacity_);
+  if constexpr (CopyOnWrite) {
+    std::swap(this->ref_cnt_, other.ref_cnt_);
+  }
+  if constexpr (Hashed) {
+    std::swap(this->hash_, other.hash_);
+  }
+  trace(StackTraceOp::kCreate, size_);
+  other.trace(StackTraceOp::kCreate, other.size_);
+}
+
+template <typename ElemTy, bool CopyOnWrite, bool Hashed>
+size_t Stack<ElemTy, CopyOnWrite, Hashed>::element_hash(const ElemTy& val) {
+  return RollingHash::mix(std::hash<ElemTy>{}(val));
+}
+
+template <typename ElemTy, bool CopyOnWrite, bool Hashed>
+void Stack<ElemTy, CopyOnWrite, Hashed>::trace(StackTraceOp op, size_t arg) const {
+#ifdef STACK_TRACE
+  StackTracer::instance().record(this, op, sizeof(ElemTy), arg);
+#else
+  (void)op;
+  (void)arg;
+#endif
+}
+
+template <typename ElemTy, bool CopyOnWrite, bool Hashed>
+void Stack<ElemTy, CopyOnWrite, Hashed>::grow() {
+  reallocate(capacity_ * grow_coeff_ + 1);
+  trace(StackTraceOp::kGrow, capacity_);
+}
+
+template <typename ElemTy, bool CopyOnWrite, bool Hashed>
+bool Stack<ElemTy, CopyOnWrite, Hashed>::shareable() const {
+  if constexpr (CopyOnWrite) {
+    return this->ref_cnt_ == nullptr ||
+           this->ref_cnt_->load(std::memory_order_relaxed) != kUnshareable;
+  }
+  return false;
+}
+
+template <typename ElemTy, bool CopyOnWrite, bool Hashed>
+void Stack<ElemTy, CopyOnWrite, Hashed>::make_unshareable() {
+  if constexpr (CopyOnWrite) {
+    detach();
+    if (this->ref_cnt_ != nullptr) {
+      this->ref_cnt_->store(kUnshareable, std::memory_order_relaxed);
+    }
+  }
 }
 
-template <typename ElemTy>
-void Stack<ElemTy>::grow() {
-  capacity_ = capacity_ * grow_coeff_ + 1;
+template <typename ElemTy, bool CopyOnWrite, bool Hashed>
+void Stack<ElemTy, CopyOnWrite, Hashed>::clone_buffer() {
   auto* new_datum = new ElemTy[capacity_];
-  std::move(data_, data_ + size_, new_datum);
-  delete[] data_;
+  std::copy(data_, data_ + size_, new_datum);
+  data_ = new_datum;
+  if constexpr (CopyOnWrite) {
+    this->ref_cnt_ = new std::atomic<size_t>{1};
+  }
+}
+
+template <typename ElemTy, bool CopyOnWrite, bool Hashed>
+void Stack<ElemTy, CopyOnWrite, Hashed>::detach() {
+  if constexpr (CopyOnWrite) {
+    if (this->ref_cnt_ != nullptr && this->ref_cnt_->load(std::memory_order_acquire) > 1) {
+      reallocate(capacity_);
+    }
+  }
+}
+
+template <typename ElemTy, bool CopyOnWrite, bool Hashed>
+void Stack<ElemTy, CopyOnWrite, Hashed>::reallocate(size_t new_capacity) {
+  auto* new_datum = new ElemTy[new_capacity];
+  if constexpr (CopyOnWrite) {
+    if (this->ref_cnt_ != nullptr && this->ref_cnt_->load(std::memory_order_acquire) > 1) {
+      std::copy(data_, data_ + size_, new_datum);
+    } else {
+      std::move(data_, data_ + size_, new_datum);
+    }
+  } else {
+    std::move(data_, data_ + size_, new_datum);
+  }
+  release();
+
   data_ = new_datum;
+  capacity_ = new_capacity;
+  if constexpr (CopyOnWrite) {
+    this->ref_cnt_ = new std::atomic<size_t>{1};
+  }
+}
+
+template <typename ElemTy, bool CopyOnWrite, bool Hashed>
+void Stack<ElemTy, CopyOnWrite, Hashed>::release() {
+  if constexpr (CopyOnWrite) {
+    if (this->ref_cnt_ == nullptr) {
+      return;
+    }
+    if (this->ref_cnt_->load(std::memory_order_acquire) != kUnshareable &&
+        this->ref_cnt_->fetch_sub(1, std::memory_order_acq_rel) != 1) {
+      return;
+    }
+    delete this->ref_cnt_;
+    this->ref_cnt_ = nullptr;
+  }
+  delete[] data_;
+}
+
+template <bool CopyOnWrite, bool Hashed>
+Stack<bool, CopyOnWrite, Hashed>::BitIterator::BitIterator(const size_t* chunks, size_t idx)
+    : chunks_(chunks), idx_(idx) {}
+
+template <bool CopyOnWrite, bool Hashed>
+bool Stack<bool, CopyOnWrite, Hashed>::BitIterator::operator*() const {
+  return ((chunks_[idx_ / kBitsInChunk] >> (idx_ % kBitsInChunk)) & 1) != 0;
+}
+
+template <bool CopyOnWrite, bool Hashed>
+typename Stack<bool, CopyOnWrite, Hashed>::BitIterator& Stack<bool, CopyOnWrite, Hashed>::BitIterator::operator++() {
+  ++idx_;
+  return *this;
+}
+
+template <bool CopyOnWrite, bool Hashed>
+typename Stack<bool, CopyOnWrite, Hashed>::BitIterator
+Stack<bool, CopyOnWrite, Hashed>::BitIterator::operator++(int) {
+  BitIterator old{*this};
+  ++idx_;
+  return old;
+}
+
+template <bool CopyOnWrite, bool Hashed>
+typename Stack<bool, CopyOnWrite, Hashed>::BitIterator& Stack<bool, CopyOnWrite, Hashed>::BitIterator::operator--() {
+  --idx_;
+  return *this;
+}
+
+template <bool CopyOnWrite, bool Hashed>
+typename Stack<bool, CopyOnWrite, Hashed>::BitIterator
+Stack<bool, CopyOnWrite, Hashed>::BitIterator::operator--(int) {
+  BitIterator old{*this};
+  --idx_;
+  return old;
+}
+
+template <bool CopyOnWrite, bool Hashed>
+bool Stack<bool, CopyOnWrite, Hashed>::BitIterator::operator==(const BitIterator& rhs) const {
+  return idx_ == rhs.idx_;
+}
+
+template <bool CopyOnWrite, bool Hashed>
+bool Stack<bool, CopyOnWrite, Hashed>::BitIterator::operator!=(const BitIterator& rhs) const {
+  return !(*this == rhs);
+}
+
+template <bool CopyOnWrite, bool Hashed>
+Stack<bool, CopyOnWrite, Hashed>::SetBitIterator::SetBitIterator(const Stack* stack,
+                                                                  size_t word_idx)
+    : stack_(stack), word_idx_(word_idx) {
+  if (word_idx_ < stack_->words_cnt()) {
+    word_ = stack_->word(word_idx_);
+    skip_empty_words();
+  }
+}
+
+template <bool CopyOnWrite, bool Hashed>
+size_t Stack<bool, CopyOnWrite, Hashed>::SetBitIterator::operator*() const {
+  return word_idx_ * kBitsInChunk + __builtin_ctzll(word_);
+}
+
+template <bool CopyOnWrite, bool Hashed>
+typename Stack<bool, CopyOnWrite, Hashed>::SetBitIterator&
+Stack<bool, CopyOnWrite, Hashed>::SetBitIterator::operator++() {
+  word_ &= word_ - 1;
+  skip_empty_words();
+  return *this;
 }
 
-inline Stack<bool>::Stack(float grow_coeff)
+template <bool CopyOnWrite, bool Hashed>
+typename Stack<bool, CopyOnWrite, Hashed>::SetBitIterator
+Stack<bool, CopyOnWrite, Hashed>::SetBitIterator::operator++(int) {
+  SetBitIterator old{*this};
+  ++*this;
+  return old;
+}
+
+template <bool CopyOnWrite, bool Hashed>
+bool Stack<bool, CopyOnWrite, Hashed>::SetBitIterator::operator==(const SetBitIterator& rhs) const {
+  return word_idx_ == rhs.word_idx_ && word_ == rhs.word_;
+}
+
+template <bool CopyOnWrite, bool Hashed>
+bool Stack<bool, CopyOnWrite, Hashed>::SetBitIterator::operator!=(const SetBitIterator& rhs) const {
+  return !(*this == rhs);
+}
+
+template <bool CopyOnWrite, bool Hashed>
+void Stack<bool, CopyOnWrite, Hashed>::SetBitIterator::skip_empty_words() {
+  while (word_ == 0 && ++word_idx_ < stack_->words_cnt()) {
+    word_ = stack_->word(word_idx_);
+  }
+}
+
+template <bool CopyOnWrite, bool Hashed>
+Stack<bool, CopyOnWrite, Hashed>::SetBitRange::SetBitRange(const Stack* stack) : stack_(stack) {}
+
+template <bool CopyOnWrite, bool Hashed>
+typename Stack<bool, CopyOnWrite, Hashed>::SetBitIterator
+Stack<bool, CopyOnWrite, Hashed>::SetBitRange::begin() const {
+  return SetBitIterator{stack_, 0};
+}
+
+template <bool CopyOnWrite, bool Hashed>
+typename Stack<bool, CopyOnWrite, Hashed>::SetBitIterator
+Stack<bool, CopyOnWrite, Hashed>::SetBitRange::end() const {
+  return SetBitIterator{stack_, stack_->words_cnt()};
+}
+
+template <bool CopyOnWrite, bool Hashed>
+Stack<bool, CopyOnWrite, Hashed>::Stack(float grow_coeff)
     : chunks_cnt_(kDefaultChunksCnt), grow_coeff_(grow_coeff) {
   chunks_ = new size_t[kDefaultChunksCnt];
+  if constexpr (CopyOnWrite) {
+    this->ref_cnt_ = new std::atomic<size_t>{1};
+  }
+  trace(StackTraceOp::kCreate, size_);
 }
 
-inline Stack<bool>::Stack(const Stack& other)
-    : size_(other.size_), chunks_cnt_(other.chunks_cnt_), grow_coeff_(other.grow_coeff_) {
-  chunks_ = new size_t[chunks_cnt_];
-  std::copy(other.chunks_, other.chunks_ + chunks_not_empty(), chunks_);
+template <bool CopyOnWrite, bool Hashed>
+Stack<bool, CopyOnWrite, Hashed>::Stack(const Stack& other)
+    : CopyOnWriteStorage<CopyOnWrite>(other),
+      HashedStorage<Hashed>(other),
+      chunks_(other.chunks_),
+      size_(other.size_),
+      chunks_cnt_(other.chunks_cnt_),
+      grow_coeff_(other.grow_coeff_) {
+  if constexpr (CopyOnWrite) {
+    if (this->ref_cnt_ != nullptr) {
+      this->ref_cnt_->fetch_add(1, std::memory_order_relaxed);
+    }
+  } else {
+    chunks_ = new size_t[chunks_cnt_];
+    std::copy(other.chunks_, other.chunks_ + chunks_not_empty(), chunks_);
+  }
+  trace(StackTraceOp::kCreate, size_);
 }
 
-inline Stack<bool>::Stack(Stack&& other) noexcept
-    : chunks_(other.chunks_),
+template <bool CopyOnWrite, bool Hashed>
+Stack<bool, CopyOnWrite, Hashed>::Stack(Stack&& other) noexcept
+    : CopyOnWriteStorage<CopyOnWrite>(other),
+      HashedStorage<Hashed>(other),
+      chunks_(other.chunks_),
       size_(other.size_),
       chunks_cnt_(other.chunks_cnt_),
       grow_coeff_(other.grow_coeff_) {
   other.chunks_ = nullptr;
   other.chunks_cnt_ = other.size_ = 0;
+  if constexpr (CopyOnWrite) {
+    other.ref_cnt_ = nullptr;
+  }
+  if constexpr (Hashed) {
+    other.hash_ = {};
+  }
+  trace(StackTraceOp::kCreate, size_);
+  other.trace(StackTraceOp::kMovedFrom, 0);
 }
 
-inline Stack<bool>::~Stack() {
-  delete[] chunks_;
+template <bool CopyOnWrite, bool Hashed>
+Stack<bool, CopyOnWrite, Hashed>::~Stack() {
+  trace(StackTraceOp::kDestroy, 0);
+  release();
 }
 
-inline Stack<bool>& Stack<bool>::operator=(const Stack& rhs) {
+template <bool CopyOnWrite, bool Hashed>
+Stack<bool, CopyOnWrite, Hashed>& Stack<bool, CopyOnWrite, Hashed>::operator=(const Stack& rhs) {
   if (this == &rhs) {
     return *this;
   }
 
+  if constexpr (CopyOnWrite) {
+    if (rhs.ref_cnt_ != nullptr) {
+      rhs.ref_cnt_->fetch_add(1, std::memory_order_relaxed);
+    }
+    release();
+
+    chunks_ = rhs.chunks_;
+    size_ = rhs.size_;
+    chunks_cnt_ = rhs.chunks_cnt_;
+    grow_coeff_ = rhs.grow_coeff_;
+    this->ref_cnt_ = rhs.ref_cnt_;
+    if constexpr (Hashed) {
+      this->hash_ = rhs.hash_;
+    }
+    trace(StackTraceOp::kCreate, size_);
+    return *this;
+  }
+
   size_ = rhs.size_;
+  if constexpr (Hashed) {
+    this->hash_ = rhs.hash_;
+  }
   size_t old_storage_units_cnt = chunks_cnt_;
   chunks_cnt_ = rhs.chunks_cnt_;
   if (old_storage_units_cnt < chunks_cnt_) {
@@ -215,30 +696,53 @@ inline Stack<bool>& Stack<bool>::operator=(const Stack& rhs) {
     chunks_ = new size_t[chunks_cnt_];
   }
   std::copy(rhs.chunks_, rhs.chunks_ + chunks_not_empty(), chunks_);
+  trace(StackTraceOp::kCreate, size_);
   return *this;
 }
 
-inline Stack<bool>& Stack<bool>::operator=(Stack&& other) noexcept {
+template <bool CopyOnWrite, bool Hashed>
+Stack<bool, CopyOnWrite, Hashed>&
+Stack<bool, CopyOnWrite, Hashed>::operator=(Stack&& other) noexcept {
   if (this == &other) {
     return *this;
   }
 
-  delete[] chunks_;
+  release();
 
   chunks_ = other.chunks_;
   size_ = other.size_;
   chunks_cnt_ = other.chunks_cnt_;
+  if constexpr (CopyOnWrite) {
+    this->ref_cnt_ = other.ref_cnt_;
+  }
+  if constexpr (Hashed) {
+    this->hash_ = other.hash_;
+  }
 
   other.chunks_ = nullptr;
   other.chunks_cnt_ = other.size_ = 0;
+  if constexpr (CopyOnWrite) {
+    other.ref_cnt_ = nullptr;
+  }
+  if constexpr (Hashed) {
+    other.hash_ = {};
+  }
+  trace(StackTraceOp::kCreate, size_);
+  other.trace(StackTraceOp::kMovedFrom, 0);
 
   return *this;
 }
 
-inline bool Stack<bool>::operator==(const Stack& rhs) const {
+template <bool CopyOnWrite, bool Hashed>
+bool Stack<bool, CopyOnWrite, Hashed>::operator==(const Stack& rhs) const {
   if (size_ != rhs.size_) {
     return false;
   }
+  if constexpr (Hashed) {
+    if (this->hash_ != rhs.hash_) {
+      return false;
+    }
+  }
 
   for (size_t i = 0; i < chunks_filled(); ++i) {
     if (chunks_[i] != rhs.chunks_[i]) {
@@ -251,7 +755,7 @@ inline bool Stack<bool>::operator==(const Stack& rhs) const {
   }
 
   for (size_t i = 0; i < bits_in_last_chunk(); ++i) {
-    if ((chunks_[chunks_filled()] & (1 << i)) != (rhs.chunks_[chunks_filled()] & (1 << i))) {
+    if ((chunks_[chunks_filled()] & (size_t{1} << i)) != (rhs.chunks_[chunks_filled()] & (size_t{1} << i))) {
       return false;
     }
   }
@@ -259,11 +763,13 @@ inline bool Stack<bool>::operator==(const Stack& rhs) const {
   return true;
 }
 
-inline bool Stack<bool>::operator!=(const Stack& rhs) const {
+template <bool CopyOnWrite, bool Hashed>
+bool Stack<bool, CopyOnWrite, Hashed>::operator!=(const Stack& rhs) const {
   return !(*this == rhs);
 }
 
-inline bool Stack<bool>::operator<(const Stack& rhs) const {
+template <bool CopyOnWrite, bool Hashed>
+bool Stack<bool, CopyOnWrite, Hashed>::operator<(const Stack& rhs) const {
   size_t min_chunks_filled = std::min(chunks_filled(), rhs.chunks_filled());
   for (size_t i = 0; i < min_chunks_filled; ++i) {
     if (chunks_[i] >= rhs.chunks_[i]) {
@@ -281,7 +787,7 @@ inline bool Stack<bool>::operator<(const Stack& rhs) const {
 
   size_t bit_mask = 0;
   for (size_t i = 0; i < min_bits_in_last_chunk; ++i) {
-    bit_mask |= (1 << i);
+    bit_mask |= (size_t{1} << i);
   }
 
   if ((chunks_[min_chunks_filled] & bit_mask) >= (rhs.chunks_[min_chunks_filled] & bit_mask)) {
@@ -295,85 +801,294 @@ inline bool Stack<bool>::operator<(const Stack& rhs) const {
   return bits_in_last_chunk() <= rhs.bits_in_last_chunk();
 }
 
-inline bool Stack<bool>::operator>(const Stack& rhs) const {
+template <bool CopyOnWrite, bool Hashed>
+bool Stack<bool, CopyOnWrite, Hashed>::operator>(const Stack& rhs) const {
   return rhs < *this;
 }
 
-inline bool Stack<bool>::operator<=(const Stack& rhs) const {
+template <bool CopyOnWrite, bool Hashed>
+bool Stack<bool, CopyOnWrite, Hashed>::operator<=(const Stack& rhs) const {
   return !(rhs < *this);
 }
 
-inline bool Stack<bool>::operator>=(const Stack& rhs) const {
+template <bool CopyOnWrite, bool Hashed>
+bool Stack<bool, CopyOnWrite, Hashed>::operator>=(const Stack& rhs) const {
   return !(*this < rhs);
 }
 
-inline bool Stack<bool>::get_top() const {
+template <bool CopyOnWrite, bool Hashed>
+bool Stack<bool, CopyOnWrite, Hashed>::get_top() const {
   assert(!empty());
-  return (chunks_[chunks_filled()] & top_bit_mask()) != 0;
+  return (chunks_[top_chunk()] & top_bit_mask()) != 0;
 }
 
-inline void Stack<bool>::set_top(bool val) {
+template <bool CopyOnWrite, bool Hashed>
+void Stack<bool, CopyOnWrite, Hashed>::set_top(bool val) {
   assert(!empty());
-  if (val) {
-    chunks_[chunks_filled()] |= top_bit_mask();
-  } else {
-    chunks_[chunks_filled()] &= ~top_bit_mask();
+  if constexpr (Hashed) {
+    this->hash_.replace_top(element_hash(get_top()), element_hash(val));
   }
+  write_top(val);
+}
+
+template <bool CopyOnWrite, bool Hashed>
+typename Stack<bool, CopyOnWrite, Hashed>::const_iterator
+Stack<bool, CopyOnWrite, Hashed>::begin() const {
+  return BitIterator{chunks_, 0};
 }
 
-inline bool Stack<bool>::empty() const {
+template <bool CopyOnWrite, bool Hashed>
+typename Stack<bool, CopyOnWrite, Hashed>::const_iterator
+Stack<bool, CopyOnWrite, Hashed>::end() const {
+  return BitIterator{chunks_, size_};
+}
+
+template <bool CopyOnWrite, bool Hashed>
+typename Stack<bool, CopyOnWrite, Hashed>::const_reverse_iterator
+Stack<bool, CopyOnWrite, Hashed>::rbegin() const {
+  return const_reverse_iterator{end()};
+}
+
+template <bool CopyOnWrite, bool Hashed>
+typename Stack<bool, CopyOnWrite, Hashed>::const_reverse_iterator
+Stack<bool, CopyOnWrite, Hashed>::rend() const {
+  return const_reverse_iterator{begin()};
+}
+
+template <bool CopyOnWrite, bool Hashed>
+size_t Stack<bool, CopyOnWrite, Hashed>::words_cnt() const {
+  return chunks_not_empty();
+}
+
+template <bool CopyOnWrite, bool Hashed>
+size_t Stack<bool, CopyOnWrite, Hashed>::word(size_t idx) const {
+  assert(idx < words_cnt());
+  if (idx < chunks_filled()) {
+    return chunks_[idx];
+  }
+  return chunks_[idx] & ((size_t{1} << bits_in_last_chunk()) - 1);
+}
+
+template <bool CopyOnWrite, bool Hashed>
+typename Stack<bool, CopyOnWrite, Hashed>::SetBitRange
+Stack<bool, CopyOnWrite, Hashed>::set_bits() const {
+  return SetBitRange{this};
+}
+
+template <bool CopyOnWrite, bool Hashed>
+bool Stack<bool, CopyOnWrite, Hashed>::empty() const {
   return size_ == 0;
 }
 
-inline size_t Stack<bool>::size() const {
+template <bool CopyOnWrite, bool Hashed>
+size_t Stack<bool, CopyOnWrite, Hashed>::size() const {
   return size_;
 }
 
-inline void Stack<bool>::push(bool val) {
+template <bool CopyOnWrite, bool Hashed>
+void Stack<bool, CopyOnWrite, Hashed>::push(bool val) {
   if (chunks_filled() < chunks_cnt_) {
-    ++size_;
-    set_top(val);
-    return;
+    if constexpr (CopyOnWrite) {
+      detach();
+    }
+  } else {
+    grow();
   }
 
-  grow();
   ++size_;
-  set_top(val);
+  write_top(val);
+  if constexpr (Hashed) {
+    this->hash_.push(element_hash(val));
+  }
+  trace(StackTraceOp::kPush, size_);
 }
 
-inline void Stack<bool>::pop() {
+template <bool CopyOnWrite, bool Hashed>
+void Stack<bool, CopyOnWrite, Hashed>::pop() {
   assert(!empty());
+  if constexpr (Hashed) {
+    this->hash_.pop(element_hash(get_top()));
+  }
   --size_;
+  trace(StackTraceOp::kPop, size_);
+}
+
+template <bool CopyOnWrite, bool Hashed>
+size_t Stack<bool, CopyOnWrite, Hashed>::hash() const {
+  if constexpr (Hashed) {
+    return this->hash_.value();
+  }
+
+  RollingHash hash;
+  for (bool val : *this) {
+    hash.push(element_hash(val));
+  }
+  return hash.value();
+}
+
+template <bool CopyOnWrite, bool Hashed>
+bool Stack<bool, CopyOnWrite, Hashed>::contains(bool val) const {
+  return depth_of(val).has_value();
+}
+
+template <bool CopyOnWrite, bool Hashed>
+std::optional<size_t> Stack<bool, CopyOnWrite, Hashed>::depth_of(bool val) const {
+  for (size_t idx = words_cnt(); idx-- > 0;) {
+    size_t bits = word(idx);
+    if (!val) {
+      bits = ~bits;
+      if (idx == chunks_filled()) {
+        bits &= (size_t{1} << bits_in_last_chunk()) - 1;
+      }
+    }
+
+    if (bits != 0) {
+      size_t pos = idx * kBitsInChunk + (kBitsInChunk - 1 - __builtin_clzll(bits));
+      return size_ - 1 - pos;
+    }
+  }
+  return std::nullopt;
+}
+
+template <bool CopyOnWrite, bool Hashed>
+size_t Stack<bool, CopyOnWrite, Hashed>::count(bool val) const {
+  size_t set_cnt = 0;
+  for (size_t idx = 0; idx < words_cnt(); ++idx) {
+    set_cnt += __builtin_popcountll(word(idx));
+  }
+  return val ? set_cnt : size_ - set_cnt;
 }
 
-inline void Stack<bool>::swap(Stack& other) {
+template <bool CopyOnWrite, bool Hashed>
+void Stack<bool, CopyOnWrite, Hashed>::swap(Stack& other) {
   std::swap(chunks_, other.chunks_);
   std::swap(size_, other.size_);
   std::swap(chunks_cnt_, other.chunks_cnt_);
+  if constexpr (CopyOnWrite) {
+    std::swap(this->ref_cnt_, other.ref_cnt_);
+  }
+  if constexpr (Hashed) {
+    std::swap(this->hash_, other.hash_);
+  }
+  trace(StackTraceOp::kCreate, size_);
+  other.trace(StackTraceOp::kCreate, other.size_);
 }
 
-inline size_t Stack<bool>::chunks_filled() const {
+template <bool CopyOnWrite, bool Hashed>
+size_t Stack<bool, CopyOnWrite, Hashed>::chunks_filled() const {
   return size_ / kBitsInChunk;
 }
 
-inline size_t Stack<bool>::bits_in_last_chunk() const {
+template <bool CopyOnWrite, bool Hashed>
+size_t Stack<bool, CopyOnWrite, Hashed>::bits_in_last_chunk() const {
   return size_ % kBitsInChunk;
 }
 
-inline size_t Stack<bool>::top_bit_mask() const {
-  return bits_in_last_chunk() == 0 ? 1 : 1 << (bits_in_last_chunk() - 1);
+template <bool CopyOnWrite, bool Hashed>
+size_t Stack<bool, CopyOnWrite, Hashed>::top_chunk() const {
+  return (size_ - 1) / kBitsInChunk;
+}
+
+template <bool CopyOnWrite, bool Hashed>
+size_t Stack<bool, CopyOnWrite, Hashed>::top_bit_mask() const {
+  return size_t{1} << ((size_ - 1) % kBitsInChunk);
+}
+
+template <bool CopyOnWrite, bool Hashed>
+size_t Stack<bool, CopyOnWrite, Hashed>::element_hash(bool val) {
+  return RollingHash::mix(static_cast<size_t>(val));
+}
+
+template <bool CopyOnWrite, bool Hashed>
+void Stack<bool, CopyOnWrite, Hashed>::write_top(bool val) {
+  if constexpr (CopyOnWrite) {
+    detach();
+  }
+  if (val) {
+    chunks_[top_chunk()] |= top_bit_mask();
+  } else {
+    chunks_[top_chunk()] &= ~top_bit_mask();
+  }
 }
 
-inline size_t Stack<bool>::chunks_not_empty() const {
+template <bool CopyOnWrite, bool Hashed>
+size_t Stack<bool, CopyOnWrite, Hashed>::chunks_not_empty() const {
   return (size_ + kBitsInChunk - 1) / kBitsInChunk;
 }
 
-inline void Stack<bool>::grow() {
-  chunks_cnt_ = chunks_cnt_ * grow_coeff_ + 1;
-  auto* new_datum = new size_t[chunks_cnt_];
-  std::move(chunks_, chunks_ + chunks_not_empty(), new_datum);
-  delete[] chunks_;
+template <bool CopyOnWrite, bool Hashed>
+void Stack<bool, CopyOnWrite, Hashed>::trace(StackTraceOp op, size_t arg) const {
+#ifdef STACK_TRACE
+  StackTracer::instance().record(this, op, 0, arg);
+#else
+  (void)op;
+  (void)arg;
+#endif
+}
+
+template <bool CopyOnWrite, bool Hashed>
+void Stack<bool, CopyOnWrite, Hashed>::grow() {
+  reallocate(chunks_cnt_ * grow_coeff_ + 1);
+  trace(StackTraceOp::kGrow, chunks_cnt_ * kBitsInChunk);
+}
+
+template <bool CopyOnWrite, bool Hashed>
+void Stack<bool, CopyOnWrite, Hashed>::detach() {
+  if constexpr (CopyOnWrite) {
+    if (this->ref_cnt_ != nullptr && this->ref_cnt_->load(std::memory_order_acquire) != 1) {
+      reallocate(chunks_cnt_);
+    }
+  }
+}
+
+template <bool CopyOnWrite, bool Hashed>
+void Stack<bool, CopyOnWrite, Hashed>::reallocate(size_t new_chunks_cnt) {
+  auto* new_datum = new size_t[new_chunks_cnt];
+  std::copy(chunks_, chunks_ + chunks_not_empty(), new_datum);
+  release();
+
   chunks_ = new_datum;
+  chunks_cnt_ = new_chunks_cnt;
+  if constexpr (CopyOnWrite) {
+    this->ref_cnt_ = new std::atomic<size_t>{1};
+  }
 }
 
+template <bool CopyOnWrite, bool Hashed>
+void Stack<bool, CopyOnWrite, Hashed>::release() {
+  if constexpr (CopyOnWrite) {
+    if (this->ref_cnt_ == nullptr ||
+        this->ref_cnt_->fetch_sub(1, std::memory_order_acq_rel) != 1) {
+      return;
+    }
+    delete this->ref_cnt_;
+    this->ref_cnt_ = nullptr;
+  }
+  delete[] chunks_;
+}
+
+template <typename ElemTy, bool CopyOnWrite, bool Hashed>
+size_t std::hash<Stack<ElemTy, CopyOnWrite, Hashed>>::operator()(
+    const Stack<ElemTy, CopyOnWrite, Hashed>& stack) const {
+  return stack.hash();
+}
+
+#ifdef STACK_EXTERN_TEMPLATES
+extern template class Stack<char>;
+extern template class Stack<signed char>;
+extern template class Stack<unsigned char>;
+extern template class Stack<short>;
+extern template class Stack<unsigned short>;
+extern template class Stack<int>;
+extern template class Stack<unsigned int>;
+extern template class Stack<long>;
+extern template class Stack<unsigned long>;
+extern template class Stack<long long>;
+extern template class Stack<unsigned long long>;
+extern template class Stack<double>;
+extern template class Stack<void*>;
+extern template class Stack<const void*>;
+extern template class Stack<bool>;
+#endif
+
 #endif /* STACK_STACK_IMPL_H */
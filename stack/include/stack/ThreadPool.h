@@ -0,0 +1,48 @@
+#ifndef STACK_THREAD_POOL_H
+#define STACK_THREAD_POOL_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool {
+ public:
+  explicit ThreadPool(size_t threads_cnt = std::thread::hardware_concurrency());
+  ThreadPool(const ThreadPool& other) = delete;
+  ThreadPool(ThreadPool&& other) = delete;
+
+  ~ThreadPool();
+
+  ThreadPool& operator=(const ThreadPool& rhs) = delete;
+  ThreadPool& operator=(ThreadPool&& other) = delete;
+
+  static ThreadPool& instance();
+
+  [[nodiscard]] size_t threads_cnt() const;
+
+  template <typename FuncTy>
+  void parallel_for(size_t size, size_t grain_size, FuncTy func);
+
+ private:
+  static constexpr std::chrono::milliseconds kIdleWaitTimeout{100};
+
+  std::vector<std::thread> workers_;
+  std::deque<std::function<void()>> tasks_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool stopping_{false};
+
+  void work();
+  bool run_pending_task(std::unique_lock<std::mutex>& lock);
+};
+
+struct ParallelPolicy {
+  ThreadPool* pool{&ThreadPool::instance()};
+};
+
+#endif /* STACK_THREAD_POOL_H */
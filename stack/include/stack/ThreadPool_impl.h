@@ -0,0 +1,116 @@
+#ifndef STACK_THREAD_POOL_IMPL_H
+#define STACK_THREAD_POOL_IMPL_H
+
+#include <algorithm>
+#include <exception>
+
+#include "stack/ThreadPool.h"
+
+inline ThreadPool::ThreadPool(size_t threads_cnt) {
+  for (size_t i = 1; i < threads_cnt; ++i) {
+    workers_.emplace_back([this] { work(); });
+  }
+}
+
+inline ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard lock{mutex_};
+    stopping_ = true;
+  }
+  cv_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+inline ThreadPool& ThreadPool::instance() {
+  static ThreadPool pool;
+  return pool;
+}
+
+inline size_t ThreadPool::threads_cnt() const {
+  return workers_.size() + 1;
+}
+
+template <typename FuncTy>
+void ThreadPool::parallel_for(size_t size, size_t grain_size, FuncTy func) {
+  size_t chunks_cnt = std::min(threads_cnt(), (size + grain_size - 1) / grain_size);
+  if (chunks_cnt <= 1) {
+    func(0, size);
+    return;
+  }
+
+  size_t chunk_size = (size + chunks_cnt - 1) / chunks_cnt;
+  chunks_cnt = (size + chunk_size - 1) / chunk_size;
+  std::vector<std::exception_ptr> errors(chunks_cnt);
+  size_t chunks_left = chunks_cnt - 1;
+  {
+    std::lock_guard lock{mutex_};
+    for (size_t i = 1; i < chunks_cnt; ++i) {
+      size_t begin = i * chunk_size;
+      size_t end = std::min(size, begin + chunk_size);
+      tasks_.emplace_back([this, &func, &errors, &chunks_left, i, begin, end] {
+        try {
+          func(begin, end);
+        } catch (...) {
+          errors[i] = std::current_exception();
+        }
+
+        std::lock_guard task_lock{mutex_};
+        if (--chunks_left == 0) {
+          cv_.notify_all();
+        }
+      });
+    }
+  }
+  cv_.notify_all();
+
+  try {
+    func(0, chunk_size);
+  } catch (...) {
+    errors[0] = std::current_exception();
+  }
+
+  {
+    std::unique_lock lock{mutex_};
+    while (chunks_left != 0) {
+      if (!run_pending_task(lock)) {
+        cv_.wait_for(lock, kIdleWaitTimeout);
+      }
+    }
+  }
+
+  for (const std::exception_ptr& error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+}
+
+inline void ThreadPool::work() {
+  std::unique_lock lock{mutex_};
+  while (true) {
+    if (run_pending_task(lock)) {
+      continue;
+    }
+    if (stopping_) {
+      return;
+    }
+    cv_.wait_for(lock, kIdleWaitTimeout);
+  }
+}
+
+inline bool ThreadPool::run_pending_task(std::unique_lock<std::mutex>& lock) {
+  if (tasks_.empty()) {
+    return false;
+  }
+
+  std::function<void()> task = std::move(tasks_.front());
+  tasks_.pop_front();
+  lock.unlock();
+  task();
+  lock.lock();
+  return true;
+}
+
+#endif /* STACK_THREAD_POOL_IMPL_H */
@@ -0,0 +1,18 @@
+#include <cstdint>
+
+#include "stack/ElementSearch.h"
+#include "stack/ElementSearchKernels_impl.h"
+
+template size_t ElementSearch::count_lanes(const uint8_t* data, size_t size, uint8_t val);
+template size_t ElementSearch::count_lanes(const uint16_t* data, size_t size, uint16_t val);
+template size_t ElementSearch::count_lanes(const uint32_t* data, size_t size, uint32_t val);
+template size_t ElementSearch::count_lanes(const uint64_t* data, size_t size, uint64_t val);
+template size_t ElementSearch::count_lanes(const float* data, size_t size, float val);
+template size_t ElementSearch::count_lanes(const double* data, size_t size, double val);
+
+template size_t ElementSearch::find_last_lanes(const uint8_t* data, size_t size, uint8_t val);
+template size_t ElementSearch::find_last_lanes(const uint16_t* data, size_t size, uint16_t val);
+template size_t ElementSearch::find_last_lanes(const uint32_t* data, size_t size, uint32_t val);
+template size_t ElementSearch::find_last_lanes(const uint64_t* data, size_t size, uint64_t val);
+template size_t ElementSearch::find_last_lanes(const float* data, size_t size, float val);
+template size_t ElementSearch::find_last_lanes(const double* data, size_t size, double val);
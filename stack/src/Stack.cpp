@@ -0,0 +1,18 @@
+#include "stack/Stack.h"
+#include "stack/Stack_impl.h"
+
+template class Stack<char>;
+template class Stack<signed char>;
+template class Stack<unsigned char>;
+template class Stack<short>;
+template class Stack<unsigned short>;
+template class Stack<int>;
+template class Stack<unsigned int>;
+template class Stack<long>;
+template class Stack<unsigned long>;
+template class Stack<long long>;
+template class Stack<unsigned long long>;
+template class Stack<double>;
+template class Stack<void*>;
+template class Stack<const void*>;
+template class Stack<bool>;
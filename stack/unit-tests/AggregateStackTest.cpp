@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <deque>
+#include <string>
+
+#include "stack/AggregateStack.h"
+#include "stack/AggregateStack_impl.h"
+
+TEST(AggregateStackTest, DefaultConstructor) {
+  AggregateStack<int, MinOp<int>> stack;
+
+  EXPECT_EQ(stack.size(), 0);
+  EXPECT_TRUE(stack.empty());
+}
+
+TEST(AggregateStackTest, Min) {
+  const size_t datum_size = 7;
+  int datum[datum_size]{5, 7, 3, 3, 8, 1, 4};
+  int expected[datum_size]{5, 5, 3, 3, 3, 1, 1};
+
+  AggregateStack<int, MinOp<int>> stack;
+  for (size_t i = 0; i < datum_size; ++i) {
+    stack.push(datum[i]);
+    EXPECT_EQ(stack.top(), datum[i]);
+    EXPECT_EQ(stack.aggregate(), expected[i]);
+  }
+
+  for (ptrdiff_t i = datum_size - 1; i >= 0; --i) {
+    EXPECT_EQ(stack.top(), datum[i]);
+    EXPECT_EQ(stack.aggregate(), expected[i]);
+    stack.pop();
+  }
+  EXPECT_TRUE(stack.empty());
+}
+
+TEST(AggregateStackTest, Max) {
+  AggregateStack<int, MaxOp<int>> stack;
+  stack.push(2);
+  stack.push(9);
+  stack.push(4);
+
+  EXPECT_EQ(stack.aggregate(), 9);
+  stack.pop();
+  stack.pop();
+  EXPECT_EQ(stack.aggregate(), 2);
+}
+
+TEST(AggregateStackTest, Sum) {
+  AggregateStack<int, SumOp<int>> stack;
+  for (int val = 1; val <= 10; ++val) {
+    stack.push(val);
+  }
+
+  EXPECT_EQ(stack.aggregate(), 55);
+  stack.pop();
+  EXPECT_EQ(stack.aggregate(), 45);
+}
+
+TEST(AggregateQueueTest, NonCommutativeOp) {
+  AggregateQueue<std::string, SumOp<std::string>> queue;
+  queue.push("a");
+  queue.push("b");
+  queue.push("c");
+  EXPECT_EQ(queue.aggregate(), "abc");
+
+  queue.pop();
+  queue.push("d");
+  EXPECT_EQ(queue.front(), "b");
+  EXPECT_EQ(queue.aggregate(), "bcd");
+
+  queue.pop();
+  queue.pop();
+  EXPECT_EQ(queue.aggregate(), "d");
+  EXPECT_EQ(queue.size(), 1);
+}
+
+TEST(AggregateQueueTest, SlidingWindowMin) {
+  const size_t window_size = 5;
+  AggregateQueue<int, MinOp<int>> queue;
+  std::deque<int> window;
+
+  for (int i = 0; i < 200; ++i) {
+    int val = (i * 37) % 101;
+    queue.push(val);
+    window.push_back(val);
+    if (window.size() > window_size) {
+      queue.pop();
+      window.pop_front();
+    }
+
+    EXPECT_EQ(queue.front(), window.front());
+    EXPECT_EQ(queue.aggregate(), *std::min_element(window.begin(), window.end()));
+  }
+}
@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "stack/MagazineDepot.h"
+#include "stack/MagazineDepot_impl.h"
+
+TEST(MagazineDepotTest, EmptyCache) {
+  MagazineDepot<int> depot;
+  MagazineCache<int> cache{depot};
+
+  EXPECT_EQ(cache.size(), 0);
+  EXPECT_FALSE(cache.pop().has_value());
+}
+
+TEST(MagazineDepotTest, LifoWithinCache) {
+  MagazineDepot<int> depot{4};
+  MagazineCache<int> cache{depot};
+
+  for (int i = 0; i < 100; ++i) {
+    cache.push(i);
+  }
+  EXPECT_EQ(cache.size(), 100 - 4 * depot.full_magazines_cnt());
+
+  for (int i = 99; i >= 0; --i) {
+    std::optional<int> val = cache.pop();
+    ASSERT_TRUE(val.has_value());
+    EXPECT_EQ(*val, i);
+  }
+  EXPECT_FALSE(cache.pop().has_value());
+  EXPECT_EQ(depot.full_magazines_cnt(), 0);
+}
+
+TEST(MagazineDepotTest, ExchangeBetweenCaches) {
+  MagazineDepot<int> depot{8};
+  MagazineCache<int> producer{depot};
+  MagazineCache<int> consumer{depot};
+
+  for (int i = 0; i < 20; ++i) {
+    producer.push(i);
+  }
+  producer.flush();
+  EXPECT_EQ(producer.size(), 0);
+
+  int sum = 0;
+  size_t popped = 0;
+  while (std::optional<int> val = consumer.pop()) {
+    sum += *val;
+    ++popped;
+  }
+  EXPECT_EQ(popped, 20);
+  EXPECT_EQ(sum, 190);
+}
+
+TEST(MagazineDepotTest, PartialMagazinesAreMerged) {
+  MagazineDepot<int> depot{4};
+  for (int i = 0; i < 3; ++i) {
+    MagazineCache<int> cache{depot};
+    cache.push(2 * i);
+    cache.push(2 * i + 1);
+    cache.flush();
+    EXPECT_EQ(depot.full_magazines_cnt(), (2 * i + 2) / 4);
+  }
+
+  MagazineCache<int> consumer{depot};
+  int sum = 0;
+  for (int i = 0; i < 6; ++i) {
+    std::optional<int> val = consumer.pop();
+    ASSERT_TRUE(val.has_value());
+    sum += *val;
+    if (i == 0) {
+      EXPECT_EQ(consumer.size(), 3);
+    }
+  }
+  EXPECT_FALSE(consumer.pop().has_value());
+  EXPECT_EQ(sum, 15);
+}
+
+TEST(MagazineDepotTest, ReclaimHook) {
+  size_t reclaimed = 0;
+  MagazineDepot<int> depot{4, [&reclaimed](int) { ++reclaimed; }};
+  {
+    MagazineCache<int> cache{depot};
+    for (int i = 0; i < 32; ++i) {
+      cache.push(i);
+    }
+    cache.flush();
+  }
+  EXPECT_EQ(depot.full_magazines_cnt(), 8);
+
+  depot.reclaim(2);
+  EXPECT_EQ(reclaimed, 24);
+  EXPECT_EQ(depot.full_magazines_cnt(), 2);
+  EXPECT_EQ(depot.empty_magazines_cnt(), 0);
+
+  depot.reclaim();
+  EXPECT_EQ(reclaimed, 32);
+  EXPECT_EQ(depot.full_magazines_cnt(), 0);
+}
+
+TEST(MagazineDepotTest, ConcurrentPool) {
+  const size_t threads_cnt = 4;
+  const size_t objects_cnt = 1000;
+  const size_t rounds_cnt = 10000;
+
+  std::atomic<size_t> reclaimed{0};
+  MagazineDepot<size_t> depot{16, [&reclaimed](size_t) { ++reclaimed; }};
+  {
+    MagazineCache<size_t> cache{depot};
+    for (size_t i = 0; i < objects_cnt; ++i) {
+      cache.push(i);
+    }
+    cache.flush();
+  }
+
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < threads_cnt; ++t) {
+    threads.emplace_back([&depot] {
+      MagazineCache<size_t> cache{depot};
+      std::vector<size_t> held;
+      for (size_t round = 0; round < rounds_cnt; ++round) {
+        if (round % 3 != 2) {
+          if (std::optional<size_t> val = cache.pop()) {
+            held.push_back(*val);
+          }
+        } else if (!held.empty()) {
+          cache.push(held.back());
+          held.pop_back();
+        }
+      }
+      for (size_t val : held) {
+        cache.push(val);
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  depot.reclaim();
+  EXPECT_EQ(reclaimed, objects_cnt);
+}
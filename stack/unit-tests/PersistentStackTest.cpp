@@ -0,0 +1,188 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "stack/PersistentStack.h"
+#include "stack/PersistentStack_impl.h"
+
+TEST(PersistentStackTest, DefaultConstructor) {
+  PersistentStack<size_t> stack;
+
+  EXPECT_EQ(stack.size(), 0);
+  EXPECT_TRUE(stack.empty());
+}
+
+TEST(PersistentStackTest, ConstructorFromContainer) {
+  const size_t datum_size = 3;
+  size_t datum[datum_size]{1, 2, 3};
+
+  PersistentStack<size_t> stack{datum, datum_size};
+
+  EXPECT_EQ(stack.size(), datum_size);
+  ASSERT_TRUE(!stack.empty());
+  EXPECT_EQ(stack.top(), datum[datum_size - 1]);
+}
+
+TEST(PersistentStackTest, Pop) {
+  const size_t datum_size = 3;
+  size_t datum[datum_size]{1, 2, 3};
+  PersistentStack<size_t> stack{datum, datum_size};
+
+  for (ptrdiff_t i = datum_size - 1; i >= 0; --i) {
+    EXPECT_EQ(stack.top(), datum[i]);
+    stack.pop();
+  }
+  EXPECT_TRUE(stack.empty());
+}
+
+TEST(PersistentStackTest, CopyIsIndependent) {
+  const size_t datum_size = 3;
+  size_t datum[datum_size]{1, 2, 3};
+
+  PersistentStack<size_t> x{datum, datum_size};
+  PersistentStack<size_t> y{x};
+
+  y.pop();
+  y.push(4);
+  x.push(5);
+
+  EXPECT_EQ(x.size(), datum_size + 1);
+  EXPECT_EQ(x.top(), 5);
+  EXPECT_EQ(y.size(), datum_size);
+  EXPECT_EQ(y.top(), 4);
+
+  x.pop();
+  y.pop();
+  y.push(3);
+  EXPECT_EQ(x, y);
+}
+
+TEST(PersistentStackTest, CopyAssignmentOperator) {
+  const size_t datum_size = 3;
+  size_t datum[datum_size]{1, 2, 3};
+
+  PersistentStack<size_t> other_stack{datum, datum_size};
+
+  PersistentStack<size_t> stack;
+  stack.push(42);
+  stack = other_stack;
+
+  EXPECT_EQ(stack.size(), other_stack.size());
+  EXPECT_EQ(stack, other_stack);
+}
+
+TEST(PersistentStackTest, MoveAssignmentOperator) {
+  const size_t datum_size = 3;
+  size_t datum[datum_size]{1, 2, 3};
+
+  PersistentStack<size_t> other_stack{datum, datum_size};
+  PersistentStack<size_t> other_stack_cp{other_stack};
+
+  PersistentStack<size_t> stack;
+  stack = std::move(other_stack);
+
+  EXPECT_EQ(stack.size(), datum_size);
+  EXPECT_EQ(stack, other_stack_cp);
+}
+
+TEST(PersistentStackTest, PushedPopped) {
+  PersistentStack<std::string> base;
+  base.push("a");
+
+  PersistentStack<std::string> left = base.pushed("b");
+  PersistentStack<std::string> right = base.pushed("c");
+
+  EXPECT_EQ(base.size(), 1);
+  EXPECT_EQ(left.top(), "b");
+  EXPECT_EQ(right.top(), "c");
+  EXPECT_NE(left, right);
+  EXPECT_EQ(left.popped(), right.popped());
+  EXPECT_EQ(left.popped(), base);
+}
+
+TEST(PersistentStackTest, Swap) {
+  const size_t datum_x_size = 3;
+  size_t datum_x[datum_x_size]{1, 2, 3};
+  const size_t datum_y_size = 2;
+  size_t datum_y[datum_y_size]{4, 5};
+
+  PersistentStack<size_t> a{datum_x, datum_x_size};
+  PersistentStack<size_t> b{a};
+  PersistentStack<size_t> c{datum_y, datum_y_size};
+  PersistentStack<size_t> d{c};
+
+  a.swap(c);
+
+  EXPECT_EQ(a, d);
+  EXPECT_EQ(c, b);
+}
+
+TEST(PersistentStackTest, DeepStackDestruction) {
+  PersistentStack<size_t, false> stack;
+  for (size_t i = 0; i < 1000000; ++i) {
+    stack.push(i);
+  }
+
+  PersistentStack<size_t, false> copy{stack};
+  stack = PersistentStack<size_t, false>{};
+  EXPECT_EQ(copy.size(), 1000000);
+}
+
+TEST(PersistentStackTest, ConcurrentSnapshots) {
+  PersistentStack<size_t> base;
+  for (size_t i = 0; i < 1000; ++i) {
+    base.push(i);
+  }
+
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < 4; ++t) {
+    threads.emplace_back([base, t] {
+      PersistentStack<size_t> stack{base};
+      for (size_t i = 0; i < 10000; ++i) {
+        PersistentStack<size_t> snapshot{stack};
+        snapshot.push(t);
+        snapshot.pop();
+        snapshot.pop();
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(base.size(), 1000);
+  EXPECT_EQ(base.top(), 999);
+}
+
+TEST(PersistentStackTest, OverAlignedElements) {
+  struct alignas(64) Wide {
+    size_t val_;
+  };
+
+  PersistentStack<Wide, false> stack;
+  for (size_t i = 0; i < 100; ++i) {
+    stack.push(Wide{i});
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(&stack.top()) % alignof(Wide), 0);
+  }
+  for (size_t i = 0; i < 50; ++i) {
+    stack.pop();
+  }
+  for (size_t i = 0; i < 50; ++i) {
+    stack.push(Wide{i});
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(&stack.top()) % alignof(Wide), 0);
+  }
+}
+
+TEST(PersistentStackTest, OutlivesThreadPool) {
+  std::thread thread{[] {
+    static thread_local PersistentStack<size_t, false> stack;
+    for (size_t i = 0; i < 100; ++i) {
+      stack.push(i);
+    }
+    stack.pop();
+  }};
+  thread.join();
+}
@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "stack/RecordStack.h"
+#include "stack/RecordStack_impl.h"
+
+struct SmallRecord {
+  uint8_t tag;
+};
+
+struct alignas(16) AlignedRecord {
+  double values[3];
+};
+
+struct CountedRecord {
+  explicit CountedRecord(size_t* alive) : alive_(alive) {
+    ++*alive_;
+  }
+  CountedRecord(CountedRecord&& other) noexcept
+      : alive_(other.alive_), name_(std::move(other.name_)) {
+    ++*alive_;
+  }
+  CountedRecord(const CountedRecord& other) = delete;
+  CountedRecord& operator=(const CountedRecord& rhs) = delete;
+  CountedRecord& operator=(CountedRecord&& other) = delete;
+  ~CountedRecord() {
+    --*alive_;
+  }
+
+  size_t* alive_;
+  std::string name_{"a string long enough to live on the heap"};
+};
+
+TEST(RecordStackTest, DefaultConstructor) {
+  RecordStack stack;
+
+  EXPECT_EQ(stack.size(), 0);
+  EXPECT_EQ(stack.bytes(), 0);
+  EXPECT_TRUE(stack.empty());
+}
+
+TEST(RecordStackTest, MixedRecords) {
+  RecordStack stack;
+  stack.emplace<SmallRecord>(SmallRecord{7});
+  auto& aligned = stack.emplace<AlignedRecord>(AlignedRecord{{1, 2, 3}});
+  stack.emplace<std::string>("top");
+
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(&aligned) % alignof(AlignedRecord), 0);
+  EXPECT_EQ(stack.size(), 3);
+  EXPECT_EQ(stack.top<std::string>(), "top");
+
+  stack.pop<std::string>();
+  EXPECT_EQ(stack.top<AlignedRecord>().values[2], 3);
+  stack.pop<AlignedRecord>();
+  EXPECT_EQ(stack.top<SmallRecord>().tag, 7);
+  stack.pop<SmallRecord>();
+  EXPECT_TRUE(stack.empty());
+  EXPECT_EQ(stack.bytes(), 0);
+}
+
+TEST(RecordStackTest, GrowRelocatesRecords) {
+  size_t alive = 0;
+  {
+    RecordStack stack(64);
+    for (size_t i = 0; i < 100; ++i) {
+      stack.emplace<CountedRecord>(&alive);
+      stack.emplace<AlignedRecord>(AlignedRecord{{static_cast<double>(i), 0, 0}});
+    }
+    EXPECT_EQ(alive, 100);
+
+    for (ptrdiff_t i = 99; i >= 50; --i) {
+      EXPECT_EQ(stack.top<AlignedRecord>().values[0], i);
+      stack.pop<AlignedRecord>();
+      EXPECT_EQ(stack.top<CountedRecord>().name_, "a string long enough to live on the heap");
+      stack.pop<CountedRecord>();
+    }
+    EXPECT_EQ(alive, 50);
+  }
+  EXPECT_EQ(alive, 0);
+}
+
+TEST(RecordStackTest, Walk) {
+  RecordStack stack;
+  for (uint8_t tag = 0; tag < 10; ++tag) {
+    stack.emplace<SmallRecord>(SmallRecord{tag});
+  }
+
+  uint8_t expected = 10;
+  stack.walk([&](void* record) {
+    EXPECT_EQ(static_cast<SmallRecord*>(record)->tag, --expected);
+  });
+  EXPECT_EQ(expected, 0);
+}
+
+TEST(RecordStackTest, MoveConstructor) {
+  RecordStack other_stack;
+  other_stack.emplace<std::string>("record");
+
+  RecordStack stack{std::move(other_stack)};
+
+  EXPECT_EQ(stack.size(), 1);
+  EXPECT_EQ(stack.top<std::string>(), "record");
+}
+
+TEST(RecordStackTest, EmplaceFromRecordBeingRelocated) {
+  RecordStack stack(64);
+  stack.emplace<std::string>("a string long enough to live on the heap");
+  for (size_t i = 0; i < 10; ++i) {
+    stack.emplace<std::string>(stack.top<std::string>());
+  }
+
+  EXPECT_EQ(stack.size(), 11);
+  while (!stack.empty()) {
+    EXPECT_EQ(stack.top<std::string>(), "a string long enough to live on the heap");
+    stack.pop<std::string>();
+  }
+}
+
+TEST(RecordStackTest, OversizedRecordThrows) {
+  struct HugeRecord {
+    char bytes[size_t{1} << 32];
+  };
+
+  RecordStack stack;
+  EXPECT_THROW(stack.emplace<HugeRecord>(), std::length_error);
+  EXPECT_TRUE(stack.empty());
+}
@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <string>
+#include <system_error>
+
+#include "stack/SharedStack.h"
+#include "stack/SharedStack_impl.h"
+
+static std::string shm_name(const char* test) {
+  return "/shared-stack-test-" + std::to_string(getpid()) + "-" + test;
+}
+
+static void wait_child(pid_t pid) {
+  int status = 0;
+  ASSERT_EQ(waitpid(pid, &status, 0), pid);
+  ASSERT_TRUE(WIFEXITED(status));
+  EXPECT_EQ(WEXITSTATUS(status), 0);
+}
+
+TEST(SharedStackTest, PushPopAndGrow) {
+  SharedStack<size_t> stack{shm_name("grow"), 4};
+  EXPECT_TRUE(stack.empty());
+  EXPECT_FALSE(stack.pop().has_value());
+
+  for (size_t i = 0; i < 100; ++i) {
+    stack.push(i);
+  }
+  EXPECT_EQ(stack.size(), 100);
+  EXPECT_EQ(stack.capacity(), 128);
+  EXPECT_EQ(stack.generation(), 5);
+
+  for (size_t i = 100; i-- > 0;) {
+    std::optional<size_t> val = stack.pop();
+    ASSERT_TRUE(val.has_value());
+    EXPECT_EQ(*val, i);
+  }
+  EXPECT_TRUE(stack.empty());
+}
+
+TEST(SharedStackTest, AttachByName) {
+  SharedStack<int> owner{shm_name("attach"), 2};
+  owner.push(1);
+
+  SharedStack<int> attached{owner.name()};
+  attached.push(2);
+  attached.push(3);
+  EXPECT_EQ(owner.size(), 3);
+
+  EXPECT_EQ(owner.pop(), 3);
+  EXPECT_EQ(attached.pop(), 2);
+  EXPECT_EQ(owner.pop(), 1);
+}
+
+TEST(SharedStackTest, AttachWaitsForCreator) {
+  std::string name = shm_name("attach-race");
+
+  pid_t pid = fork();
+  ASSERT_NE(pid, -1);
+  if (pid == 0) {
+    while (true) {
+      try {
+        SharedStack<int> child{name};
+        child.push(7);
+        _exit(0);
+      } catch (const std::system_error& e) {
+        if (e.code().value() != ENOENT) {
+          _exit(1);
+        }
+      }
+    }
+  }
+
+  SharedStack<int> owner{name, 2};
+  wait_child(pid);
+  EXPECT_EQ(owner.pop(), 7);
+}
+
+TEST(SharedStackTest, AttachTimesOutOnUninitializedObject) {
+  std::string name = shm_name("uninitialized");
+  int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+  ASSERT_NE(fd, -1);
+
+  try {
+    SharedStack<int> attached{name};
+    ADD_FAILURE();
+  } catch (const std::system_error& e) {
+    EXPECT_EQ(e.code().value(), ETIMEDOUT);
+  }
+
+  close(fd);
+  shm_unlink(name.c_str());
+}
+
+TEST(SharedStackTest, ForkedProducerRemapsOnGrowth) {
+  const size_t items_cnt = 10000;
+  SharedStack<size_t> stack{shm_name("fork"), 16};
+
+  pid_t pid = fork();
+  ASSERT_NE(pid, -1);
+  if (pid == 0) {
+    SharedStack<size_t> child{stack.name()};
+    for (size_t i = 1; i <= items_cnt; ++i) {
+      child.push(i);
+    }
+    _exit(0);
+  }
+  wait_child(pid);
+
+  EXPECT_EQ(stack.size(), items_cnt);
+  EXPECT_GT(stack.generation(), 0);
+  size_t sum = 0;
+  while (std::optional<size_t> val = stack.pop()) {
+    sum += *val;
+  }
+  EXPECT_EQ(sum, items_cnt * (items_cnt + 1) / 2);
+}
+
+TEST(SharedStackTest, ConcurrentProcesses) {
+  const size_t processes_cnt = 4;
+  const size_t items_cnt = 5000;
+  SharedStack<size_t> stack{shm_name("concurrent"), 8};
+
+  pid_t pids[processes_cnt];
+  for (size_t p = 0; p < processes_cnt; ++p) {
+    pids[p] = fork();
+    ASSERT_NE(pids[p], -1);
+    if (pids[p] == 0) {
+      SharedStack<size_t> child{stack.name()};
+      for (size_t i = 0; i < items_cnt; ++i) {
+        child.push(p);
+        if (i % 3 == 0) {
+          child.pop();
+        }
+      }
+      _exit(0);
+    }
+  }
+  for (pid_t pid : pids) {
+    wait_child(pid);
+  }
+
+  EXPECT_EQ(stack.size(), processes_cnt * (items_cnt - (items_cnt + 2) / 3));
+}
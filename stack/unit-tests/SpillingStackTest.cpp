@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+#include "stack/SpillingStack.h"
+#include "stack/SpillingStack_impl.h"
+
+static const size_t kSegmentSize = 16;
+static const size_t kMemoryBudget = 4 * kSegmentSize * sizeof(size_t);
+
+TEST(SpillingStackTest, Constructor) {
+  SpillingStack<size_t> stack(kMemoryBudget, kSegmentSize);
+
+  EXPECT_EQ(stack.size(), 0);
+  EXPECT_TRUE(stack.empty());
+  EXPECT_EQ(stack.spilled_segments_cnt(), 0);
+}
+
+TEST(SpillingStackTest, PushPop) {
+  const size_t stack_size = 1000;
+  SpillingStack<size_t> stack(kMemoryBudget, kSegmentSize);
+
+  for (size_t val = 0; val < stack_size; ++val) {
+    stack.push(val);
+    EXPECT_EQ(stack.top(), val);
+  }
+  EXPECT_EQ(stack.size(), stack_size);
+  EXPECT_GT(stack.spilled_segments_cnt(), 0);
+
+  for (ptrdiff_t val = stack_size - 1; val >= 0; --val) {
+    ASSERT_EQ(stack.top(), val);
+    stack.pop();
+  }
+  EXPECT_TRUE(stack.empty());
+  EXPECT_EQ(stack.spilled_segments_cnt(), 0);
+}
+
+TEST(SpillingStackTest, OscillateAroundSpilledRegion) {
+  SpillingStack<size_t> stack(kMemoryBudget, kSegmentSize);
+  for (size_t val = 0; val < 200; ++val) {
+    stack.push(val);
+  }
+
+  for (size_t round = 0; round < 20; ++round) {
+    for (size_t i = 0; i < 40; ++i) {
+      stack.pop();
+    }
+    EXPECT_EQ(stack.top(), 159);
+    for (size_t i = 0; i < 40; ++i) {
+      stack.push(160 + i);
+    }
+    EXPECT_EQ(stack.top(), 199);
+  }
+}
+
+TEST(SpillingStackTest, TopModificationSurvivesSpill) {
+  SpillingStack<size_t> stack(kMemoryBudget, kSegmentSize);
+  stack.push(1);
+  stack.top() = 2;
+
+  for (size_t val = 0; val < 500; ++val) {
+    stack.push(val);
+  }
+  for (size_t val = 0; val < 500; ++val) {
+    stack.pop();
+  }
+
+  EXPECT_EQ(stack.top(), 2);
+}
+
+TEST(SpillingStackTest, BuffersStayWithinBudget) {
+  for (size_t budget_segments = 0; budget_segments <= 5; ++budget_segments) {
+    const size_t max_buffers = std::max<size_t>(budget_segments, 1);
+    SpillingStack<size_t> stack(budget_segments * kSegmentSize * sizeof(size_t), kSegmentSize);
+
+    for (size_t round = 0; round < 10; ++round) {
+      for (size_t val = 0; val < 300; ++val) {
+        stack.push(val);
+        ASSERT_LE(stack.buffers_cnt(), max_buffers);
+      }
+      for (size_t i = 0; i < 250 + round * 5; ++i) {
+        stack.pop();
+        ASSERT_LE(stack.buffers_cnt(), max_buffers);
+      }
+    }
+
+    while (!stack.empty()) {
+      stack.pop();
+      ASSERT_LE(stack.buffers_cnt(), max_buffers);
+    }
+  }
+}
@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "stack/StackArena.h"
+#include "stack/StackArena_impl.h"
+
+TEST(TwoStackArenaTest, DefaultConstructor) {
+  TwoStackArena<size_t> arena(2);
+
+  EXPECT_TRUE(arena.stack(TwoStackArena<size_t>::kLower).empty());
+  EXPECT_TRUE(arena.stack(TwoStackArena<size_t>::kUpper).empty());
+}
+
+TEST(TwoStackArenaTest, PushPop) {
+  TwoStackArena<size_t> arena(2);
+  auto lower = arena.stack(TwoStackArena<size_t>::kLower);
+  auto upper = arena.stack(TwoStackArena<size_t>::kUpper);
+
+  const size_t stack_size = 100;
+  for (size_t val = 0; val < stack_size; ++val) {
+    lower.push(val);
+    upper.push(stack_size + val);
+    EXPECT_EQ(lower.top(), val);
+    EXPECT_EQ(upper.top(), stack_size + val);
+  }
+  EXPECT_GE(arena.capacity(), 2 * stack_size);
+
+  for (ptrdiff_t val = stack_size - 1; val >= 0; --val) {
+    EXPECT_EQ(lower.top(), val);
+    EXPECT_EQ(upper.top(), stack_size + val);
+    lower.pop();
+    upper.pop();
+  }
+  EXPECT_TRUE(lower.empty());
+  EXPECT_TRUE(upper.empty());
+}
+
+TEST(TwoStackArenaTest, SharesCapacity) {
+  TwoStackArena<size_t> arena(2);
+  auto lower = arena.stack(TwoStackArena<size_t>::kLower);
+
+  size_t capacity = arena.capacity();
+  for (size_t val = 0; val < capacity; ++val) {
+    lower.push(val);
+  }
+  EXPECT_EQ(arena.capacity(), capacity);
+
+  lower.top() = 42;
+  EXPECT_EQ(lower.top(), 42);
+  EXPECT_EQ(lower.size(), capacity);
+}
+
+TEST(StackArenaTest, Constructor) {
+  const size_t stacks_cnt = 10;
+  StackArena<size_t> arena(stacks_cnt);
+
+  EXPECT_EQ(arena.stacks_cnt(), stacks_cnt);
+  for (size_t i = 0; i < stacks_cnt; ++i) {
+    EXPECT_TRUE(arena.stack(i).empty());
+  }
+}
+
+TEST(StackArenaTest, InterleavedPushPop) {
+  const size_t stacks_cnt = 16;
+  StackArena<size_t> arena(stacks_cnt, 2);
+  std::vector<std::vector<size_t>> expected(stacks_cnt);
+
+  for (size_t step = 0; step < 10000; ++step) {
+    size_t idx = (step * 7 + step / 13) % stacks_cnt;
+    auto stack = arena.stack(idx);
+    if (step % 5 == 4 && !stack.empty()) {
+      stack.pop();
+      expected[idx].pop_back();
+    } else {
+      stack.push(step);
+      expected[idx].push_back(step);
+    }
+  }
+
+  for (size_t idx = 0; idx < stacks_cnt; ++idx) {
+    auto stack = arena.stack(idx);
+    ASSERT_EQ(stack.size(), expected[idx].size());
+    while (!stack.empty()) {
+      EXPECT_EQ(stack.top(), expected[idx].back());
+      stack.pop();
+      expected[idx].pop_back();
+    }
+  }
+}
+
+TEST(StackArenaTest, Compact) {
+  const size_t stacks_cnt = 4;
+  StackArena<size_t> arena(stacks_cnt);
+
+  for (size_t val = 0; val < 100; ++val) {
+    arena.stack(val % stacks_cnt).push(val);
+  }
+  arena.compact();
+
+  for (size_t idx = 0; idx < stacks_cnt; ++idx) {
+    EXPECT_EQ(arena.stack(idx).size(), 25);
+    EXPECT_EQ(arena.stack(idx).top(), 96 + idx);
+  }
+
+  arena.stack(0).push(1000);
+  EXPECT_EQ(arena.stack(0).top(), 1000);
+  EXPECT_EQ(arena.stack(1).top(), 97);
+}
@@ -1,5 +1,18 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "stack/ParallelStack.h"
+#include "stack/ParallelStack_impl.h"
 #include "stack/Stack.h"
 #include "stack/Stack_impl.h"
 
@@ -256,6 +269,33 @@ TEST(StackTest, Push) {
   }
 }
 
+TEST(StackTest, Reserve) {
+  Stack<size_t> stack;
+  stack.push(0);
+  stack.reserve(100);
+  EXPECT_EQ(stack.size(), 1);
+  EXPECT_EQ(stack.top(), 0);
+
+  const size_t* data = stack.data();
+  for (size_t val = 1; val < 100; ++val) {
+    stack.push(val);
+  }
+  EXPECT_EQ(stack.data(), data);
+  EXPECT_EQ(stack.top(), 99);
+}
+
+TEST(StackTest, ReserveDetachesSharedBuffer) {
+  Stack<size_t, true> stack;
+  stack.push(1);
+  Stack<size_t, true> copy{stack};
+
+  stack.reserve(100);
+  stack.push(2);
+  EXPECT_EQ(copy.size(), 1);
+  EXPECT_EQ(copy.top(), 1);
+  EXPECT_EQ(stack.top(), 2);
+}
+
 TEST(BoolSpecializationStackTest, DefaultConstructor) {
   Stack<bool> stack(2);
 
@@ -519,3 +559,554 @@ TEST(BoolSpecializationStackTest, Pop) {
     stack.pop();
   }
 }
+
+TEST(CopyOnWriteStackTest, CopySharesUntilWrite) {
+  const size_t datum_size = 3;
+  size_t datum[datum_size]{1, 2, 3};
+
+  Stack<size_t, true> x{datum, datum_size};
+  Stack<size_t, true> y{x};
+  const Stack<size_t, true>& const_x = x;
+  const Stack<size_t, true>& const_y = y;
+
+  EXPECT_EQ(&const_x.top(), &const_y.top());
+
+  y.top() = 4;
+  EXPECT_EQ(x.top(), 3);
+  EXPECT_EQ(const_y.top(), 4);
+}
+
+TEST(CopyOnWriteStackTest, PushDetaches) {
+  Stack<size_t, true> x(2);
+  for (size_t val = 0; val < 100; ++val) {
+    x.push(val);
+  }
+
+  Stack<size_t, true> y(2);
+  y = x;
+  y.pop();
+  y.push(42);
+  x.push(43);
+
+  EXPECT_EQ(x.size(), 101);
+  EXPECT_EQ(x.top(), 43);
+  x.pop();
+  EXPECT_EQ(x.top(), 99);
+  EXPECT_EQ(y.size(), 100);
+  EXPECT_EQ(y.top(), 42);
+  y.pop();
+  EXPECT_EQ(y.top(), 98);
+}
+
+TEST(CopyOnWriteStackTest, MovedFromCopy) {
+  Stack<size_t, true> x(2);
+  x.push(1);
+  Stack<size_t, true> y{std::move(x)};
+  Stack<size_t, true> z{x}; // NOLINT(bugprone-use-after-move)
+
+  z.push(2);
+  EXPECT_EQ(z.size(), 1);
+  EXPECT_EQ(y.top(), 1);
+}
+
+TEST(CopyOnWriteStackTest, HeldReferenceStaysPrivate) {
+  Stack<int, true> a;
+  a.push(1);
+  int& top = a.top();
+
+  Stack<int, true> b{a};
+  Stack<int, true> c;
+  c = a;
+  top = 42;
+
+  EXPECT_EQ(a.top(), 42);
+  EXPECT_EQ(b.top(), 1);
+  EXPECT_EQ(c.top(), 1);
+}
+
+TEST(CopyOnWriteStackTest, HeldPointerStaysPrivate) {
+  Stack<int, true> a;
+  for (int i = 0; i < 10; ++i) {
+    a.push(i);
+  }
+  int* data = a.data();
+
+  Stack<int, true> b{a};
+  data[0] = 42;
+  EXPECT_EQ(std::as_const(b).data()[0], 0);
+  EXPECT_NE(std::as_const(a).data(), std::as_const(b).data());
+}
+
+TEST(CopyOnWriteStackTest, ReallocationRestoresSharing) {
+  Stack<int, true> a(2);
+  a.push(1);
+  a.top() = 2;
+  for (int i = 0; i < 100; ++i) {
+    a.push(i);
+  }
+
+  Stack<int, true> b{a};
+  EXPECT_EQ(std::as_const(a).data(), std::as_const(b).data());
+}
+
+TEST(CopyOnWriteStackTest, RefCountStoredOnlyWhenEnabled) {
+  EXPECT_EQ(sizeof(Stack<size_t, true>), sizeof(Stack<size_t>) + sizeof(void*));
+  EXPECT_EQ(sizeof(Stack<bool, true>), sizeof(Stack<bool>) + sizeof(void*));
+}
+
+TEST(CopyOnWriteBoolSpecializationStackTest, SetTopDetaches) {
+  const size_t stack_size = 100;
+  Stack<bool, true> x(2);
+  for (size_t val = 1; val <= stack_size; ++val) {
+    x.push(val % 2 == 0);
+  }
+
+  Stack<bool, true> y{x};
+  EXPECT_EQ(x, y);
+
+  y.set_top(stack_size % 2 != 0);
+  EXPECT_EQ(x.get_top(), stack_size % 2 == 0);
+  EXPECT_EQ(y.get_top(), stack_size % 2 != 0);
+  EXPECT_NE(x, y);
+}
+
+TEST(CopyOnWriteBoolSpecializationStackTest, PushDetaches) {
+  Stack<bool, true> x(2);
+  x.push(true);
+
+  Stack<bool, true> y(2);
+  y = x;
+  y.pop();
+  y.push(false);
+
+  EXPECT_TRUE(x.get_top());
+  EXPECT_FALSE(y.get_top());
+  EXPECT_EQ(x.size(), y.size());
+}
+
+TEST(StackTest, Iteration) {
+  const size_t datum_size = 3;
+  size_t datum[datum_size]{1, 2, 3};
+
+  const Stack<size_t> stack{datum, datum_size};
+
+  EXPECT_TRUE(std::equal(stack.begin(), stack.end(), datum, datum + datum_size));
+  EXPECT_TRUE(std::equal(stack.rbegin(), stack.rend(), std::rbegin(datum), std::rend(datum)));
+  EXPECT_EQ(stack.data()[0], 1);
+
+  Span<const size_t> span = stack.span();
+  ASSERT_EQ(span.size(), datum_size);
+  EXPECT_EQ(span[datum_size - 1], stack.top());
+}
+
+TEST(StackTest, MutableSpan) {
+  Stack<size_t> stack(2);
+  for (size_t val = 0; val < 10; ++val) {
+    stack.push(val);
+  }
+
+  for (size_t& val : stack.span()) {
+    val *= 2;
+  }
+  EXPECT_EQ(stack.top(), 18);
+}
+
+TEST(CopyOnWriteStackTest, MutableIterationDetaches) {
+  Stack<size_t, true> x(2);
+  x.push(1);
+  Stack<size_t, true> y{x};
+
+  *y.begin() = 2;
+  EXPECT_EQ(*std::as_const(x).begin(), 1);
+  EXPECT_EQ(y.top(), 2);
+}
+
+TEST(BoolSpecializationStackTest, PushPopAcrossChunks) {
+  const size_t stack_size = 300;
+  Stack<bool> stack(2);
+  for (size_t val = 0; val < stack_size; ++val) {
+    stack.push(val % 3 == 0);
+    EXPECT_EQ(stack.get_top(), val % 3 == 0);
+  }
+
+  for (ptrdiff_t val = stack_size - 1; val >= 0; --val) {
+    EXPECT_EQ(stack.get_top(), val % 3 == 0);
+    stack.pop();
+  }
+}
+
+TEST(BoolSpecializationStackTest, Iteration) {
+  const size_t stack_size = 150;
+  Stack<bool> stack(2);
+  for (size_t val = 0; val < stack_size; ++val) {
+    stack.push(val % 3 == 0);
+  }
+
+  size_t idx = 0;
+  for (bool bit : stack) {
+    EXPECT_EQ(bit, idx++ % 3 == 0);
+  }
+  EXPECT_EQ(idx, stack_size);
+
+  for (auto it = stack.rbegin(); it != stack.rend(); ++it) {
+    EXPECT_EQ(*it, --idx % 3 == 0);
+  }
+  EXPECT_EQ(idx, 0);
+}
+
+TEST(BoolSpecializationStackTest, SetBits) {
+  const size_t stack_size = 150;
+  Stack<bool> stack(2);
+  for (size_t val = 0; val < stack_size; ++val) {
+    stack.push(true);
+  }
+  for (size_t val = 0; val < stack_size / 2; ++val) {
+    stack.pop();
+  }
+  for (size_t val = 0; val < stack_size / 2; ++val) {
+    stack.push(val % 7 == 0);
+  }
+
+  ASSERT_EQ(stack.words_cnt(), (stack_size + 63) / 64);
+  size_t expected = 0;
+  for (size_t idx : stack.set_bits()) {
+    while (expected >= stack_size / 2 && (expected - stack_size / 2) % 7 != 0) {
+      ++expected;
+    }
+    EXPECT_EQ(idx, expected++);
+  }
+  EXPECT_EQ(expected, stack_size - 4);
+}
+
+TEST(StackTest, ParallelCopyAndCompare) {
+  ThreadPool pool(4);
+  const size_t datum_size = 1 << 20;
+  auto* datum = new size_t[datum_size];
+  for (size_t i = 0; i < datum_size; ++i) {
+    datum[i] = i;
+  }
+
+  Stack<size_t> x = ParallelStack::copy(ParallelPolicy{&pool}, datum, datum_size);
+  Stack<size_t> y = ParallelStack::copy(ParallelPolicy{&pool}, x);
+  delete[] datum;
+
+  EXPECT_EQ(x.size(), datum_size);
+  EXPECT_EQ(x, y);
+  EXPECT_TRUE(ParallelStack::equals(ParallelPolicy{&pool}, x, y));
+  EXPECT_FALSE(ParallelStack::less(ParallelPolicy{&pool}, x, y));
+
+  y.data()[datum_size / 2 + 1] += 1;
+  EXPECT_FALSE(ParallelStack::equals(ParallelPolicy{&pool}, x, y));
+
+  Stack<size_t> z = ParallelStack::copy(ParallelPolicy{}, x);
+  for (size_t& val : z.span()) {
+    ++val;
+  }
+  EXPECT_TRUE(ParallelStack::less(ParallelPolicy{&pool}, x, z));
+  EXPECT_EQ(ParallelStack::less(ParallelPolicy{&pool}, x, z), x < z);
+  z.pop();
+  EXPECT_FALSE(ParallelStack::less(ParallelPolicy{&pool}, x, z));
+}
+
+struct ThrowingCopy {
+  int val_{0};
+
+  ThrowingCopy() = default;
+  ThrowingCopy(const ThrowingCopy& other) = default;
+
+  ThrowingCopy& operator=(const ThrowingCopy& rhs) {
+    if (rhs.val_ < 0) {
+      throw std::runtime_error("copy");
+    }
+    val_ = rhs.val_;
+    return *this;
+  }
+};
+
+namespace std {
+
+template <>
+struct hash<ThrowingCopy> {
+  size_t operator()(const ThrowingCopy& val) const { return std::hash<int>{}(val.val_); }
+};
+
+}  // namespace std
+
+TEST(StackTest, ParallelCopyPropagatesExceptions) {
+  ThreadPool pool(4);
+  const size_t datum_size = 1 << 18;
+  std::vector<ThrowingCopy> datum(datum_size);
+
+  for (size_t bad_idx : {size_t{0}, datum_size - 1}) {
+    datum[bad_idx].val_ = -1;
+    EXPECT_THROW(ParallelStack::copy(ParallelPolicy{&pool}, datum.data(), datum_size),
+                 std::runtime_error);
+    datum[bad_idx].val_ = 0;
+  }
+
+  Stack<ThrowingCopy> copy = ParallelStack::copy(ParallelPolicy{&pool}, datum.data(), datum_size);
+  EXPECT_EQ(copy.size(), datum_size);
+}
+
+TEST(HashedStackTest, IncrementalHashMatchesRecomputed) {
+  Stack<int, false, true> hashed;
+  Stack<int> plain;
+  for (int i = 0; i < 100; ++i) {
+    hashed.push(i * 7 % 13);
+    plain.push(i * 7 % 13);
+    if (i % 3 == 2) {
+      hashed.pop();
+      plain.pop();
+    }
+    EXPECT_EQ(hashed.hash(), plain.hash());
+  }
+
+  while (!hashed.empty()) {
+    hashed.pop();
+  }
+  EXPECT_EQ(hashed.hash(), Stack<int>{}.hash());
+}
+
+TEST(HashedStackTest, FailedPushKeepsHash) {
+  Stack<ThrowingCopy, false, true> stack;
+  ThrowingCopy good;
+  good.val_ = 1;
+  stack.push(good);
+  size_t hash = stack.hash();
+
+  ThrowingCopy bad;
+  bad.val_ = -1;
+  EXPECT_THROW(stack.push(bad), std::runtime_error);
+  EXPECT_EQ(stack.size(), 1);
+  EXPECT_EQ(stack.hash(), hash);
+
+  stack.push(good);
+  Stack<ThrowingCopy, false, true> expected;
+  expected.push(good);
+  expected.push(good);
+  EXPECT_EQ(stack.hash(), expected.hash());
+}
+
+TEST(HashedStackTest, DistinguishesOrderAndSize) {
+  Stack<int, false, true> x;
+  Stack<int, false, true> y;
+  x.push(1);
+  x.push(2);
+  y.push(2);
+  y.push(1);
+  EXPECT_NE(x.hash(), y.hash());
+  EXPECT_NE(x, y);
+
+  Stack<int, false, true> zeros;
+  size_t empty_hash = zeros.hash();
+  zeros.push(0);
+  size_t one_zero_hash = zeros.hash();
+  zeros.push(0);
+  EXPECT_NE(empty_hash, one_zero_hash);
+  EXPECT_NE(one_zero_hash, zeros.hash());
+}
+
+TEST(HashedStackTest, CopyMoveAndSwap) {
+  Stack<int, true, true> x;
+  for (int i = 0; i < 50; ++i) {
+    x.push(i);
+  }
+
+  Stack<int, true, true> y{x};
+  EXPECT_EQ(x.hash(), y.hash());
+  EXPECT_EQ(x, y);
+
+  y.pop();
+  y.push(100);
+  EXPECT_NE(x.hash(), y.hash());
+  EXPECT_NE(x, y);
+
+  size_t x_hash = x.hash();
+  size_t y_hash = y.hash();
+  x.swap(y);
+  EXPECT_EQ(x.hash(), y_hash);
+  EXPECT_EQ(y.hash(), x_hash);
+
+  Stack<int, true, true> z{std::move(x)};
+  EXPECT_EQ(z.hash(), y_hash);
+}
+
+TEST(HashedStackTest, HashStoredOnlyWhenEnabled) {
+  EXPECT_EQ(sizeof(Stack<int>), 4 * sizeof(size_t));
+  EXPECT_EQ(sizeof(Stack<int, false, true>), sizeof(Stack<int>) + sizeof(RollingHash));
+  EXPECT_EQ(sizeof(Stack<bool, false, true>), sizeof(Stack<bool>) + sizeof(RollingHash));
+}
+
+TEST(HashedStackTest, MutableAccessIsReadOnly) {
+  Stack<int, true, true> x;
+  for (int i = 0; i < 10; ++i) {
+    x.push(i);
+  }
+  Stack<int, true, true> y{x};
+
+  static_assert(std::is_same_v<decltype(x.top()), const int&>);
+  static_assert(std::is_same_v<decltype(x.data()), const int*>);
+  static_assert(std::is_same_v<decltype(*x.begin()), const int&>);
+  EXPECT_EQ(x.top(), 9);
+  EXPECT_EQ(x.data(), y.data());
+  EXPECT_EQ(x.span().size(), 10);
+
+  int sum = 0;
+  for (const int& val : x) {
+    sum += val;
+  }
+  EXPECT_EQ(sum, 45);
+  EXPECT_EQ(x.hash(), y.hash());
+}
+
+TEST(HashedStackTest, ParallelConstructor) {
+  ThreadPool pool(4);
+  const size_t datum_size = 1 << 18;
+  auto* datum = new size_t[datum_size];
+  for (size_t i = 0; i < datum_size; ++i) {
+    datum[i] = i * i;
+  }
+
+  Stack<size_t, false, true> serial{datum, datum_size};
+  Stack<size_t, false, true> parallel =
+      ParallelStack::copy<size_t, false, true>(ParallelPolicy{&pool}, datum, datum_size);
+  delete[] datum;
+
+  EXPECT_EQ(serial.hash(), parallel.hash());
+  EXPECT_EQ(serial, parallel);
+}
+
+TEST(HashedStackTest, BoolSetTop) {
+  Stack<bool, false, true> hashed;
+  Stack<bool> plain;
+  for (size_t i = 0; i < 200; ++i) {
+    hashed.push(i % 3 == 0);
+    plain.push(i % 3 == 0);
+    if (i % 5 == 0) {
+      hashed.set_top(!hashed.get_top());
+      plain.set_top(!plain.get_top());
+    }
+    EXPECT_EQ(hashed.hash(), plain.hash());
+  }
+
+  for (size_t i = 0; i < 150; ++i) {
+    hashed.pop();
+    plain.pop();
+  }
+  EXPECT_EQ(hashed.hash(), plain.hash());
+}
+
+TEST(HashedStackTest, UnorderedSet) {
+  std::unordered_set<Stack<int, true, true>> states;
+  Stack<int, true, true> state;
+  for (int step = 0; step < 1000; ++step) {
+    if (step % 4 == 3) {
+      state.pop();
+    } else {
+      state.push(step % 3);
+    }
+    states.insert(state);
+  }
+
+  Stack<int, true, true> probe;
+  probe.push(0);
+  EXPECT_EQ(states.count(probe), 1);
+  probe.push(7);
+  EXPECT_EQ(states.count(probe), 0);
+}
+
+template <typename ElemTy>
+static void expect_search_matches_naive(const Stack<ElemTy>& stack, const ElemTy& val) {
+  size_t cnt = 0;
+  std::optional<size_t> depth;
+  for (auto it = stack.rbegin(); it != stack.rend(); ++it) {
+    if (*it == val) {
+      if (!depth.has_value()) {
+        depth = static_cast<size_t>(it - stack.rbegin());
+      }
+      ++cnt;
+    }
+  }
+
+  EXPECT_EQ(stack.count(val), cnt);
+  EXPECT_EQ(stack.depth_of(val), depth);
+  EXPECT_EQ(stack.contains(val), depth.has_value());
+}
+
+template <typename ElemTy>
+class StackSearchTest : public testing::Test {};
+
+using SearchTypes = testing::Types<int8_t, uint16_t, int, uint32_t, int64_t, size_t, float, double>;
+TYPED_TEST_SUITE(StackSearchTest, SearchTypes);
+
+TYPED_TEST(StackSearchTest, MatchesNaiveScan) {
+  for (size_t size : {0, 1, 7, 15, 16, 17, 31, 32, 33, 100, 1000}) {
+    Stack<TypeParam> stack;
+    for (size_t i = 0; i < size; ++i) {
+      stack.push(static_cast<TypeParam>(i * 7 % 11));
+    }
+    for (int val = -1; val <= 11; ++val) {
+      expect_search_matches_naive(stack, static_cast<TypeParam>(val));
+    }
+  }
+}
+
+TEST(StackSearchTest, FloatingPointEquality) {
+  Stack<double> stack;
+  stack.push(std::nan(""));
+  stack.push(-0.0);
+  stack.push(1.5);
+
+  EXPECT_FALSE(stack.contains(std::nan("")));
+  EXPECT_EQ(stack.depth_of(0.0), 1);
+  EXPECT_EQ(stack.count(0.0), 1);
+}
+
+TEST(StackSearchTest, NonArithmetic) {
+  Stack<std::string> stack;
+  stack.push("a");
+  stack.push("b");
+  stack.push("a");
+  stack.push("c");
+
+  EXPECT_EQ(stack.depth_of("a"), 1);
+  EXPECT_EQ(stack.count("a"), 2);
+  EXPECT_FALSE(stack.contains("d"));
+  EXPECT_EQ(stack.depth_of("d"), std::nullopt);
+}
+
+TEST(StackSearchTest, Bool) {
+  for (size_t size : {0, 1, 63, 64, 65, 200}) {
+    Stack<bool> stack;
+    size_t set_cnt = 0;
+    for (size_t i = 0; i < size; ++i) {
+      bool val = i % 5 == 0;
+      stack.push(val);
+      set_cnt += val ? 1 : 0;
+    }
+
+    EXPECT_EQ(stack.count(true), set_cnt);
+    EXPECT_EQ(stack.count(false), size - set_cnt);
+    for (bool val : {false, true}) {
+      std::optional<size_t> depth;
+      size_t idx = 0;
+      for (auto it = stack.rbegin(); it != stack.rend(); ++it, ++idx) {
+        if (*it == val) {
+          depth = idx;
+          break;
+        }
+      }
+      EXPECT_EQ(stack.depth_of(val), depth);
+      EXPECT_EQ(stack.contains(val), depth.has_value());
+    }
+  }
+
+  Stack<bool> ones;
+  for (size_t i = 0; i < 64; ++i) {
+    ones.push(true);
+  }
+  EXPECT_FALSE(ones.contains(false));
+  ones.push(false);
+  ones.pop();
+  EXPECT_FALSE(ones.contains(false));
+}
@@ -0,0 +1,268 @@
+#include <gtest/gtest.h>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include "stack/PersistentStack.h"
+#include "stack/PersistentStack_impl.h"
+#include "stack/Stack.h"
+#include "stack/Stack_impl.h"
+#include "stack/StackTracer.h"
+#include "stack/StackTracer_impl.h"
+
+using Op = StackTracer::Op;
+
+static std::string trace_path(const char* test) {
+  return "/tmp/stack-tracer-test-" + std::to_string(getpid()) + "-" + test + ".trace";
+}
+
+TEST(StackTracerTest, RoundTrip) {
+  std::string path = trace_path("round-trip");
+  int stack = 0;
+
+  StackTracer& tracer = StackTracer::instance();
+  tracer.start(path);
+  EXPECT_TRUE(tracer.active());
+  tracer.record(&stack, Op::kCreate, sizeof(int), 0);
+  tracer.record(&stack, Op::kPush, sizeof(int), 1);
+  tracer.record(&stack, Op::kGrow, sizeof(int), 11);
+  tracer.record(&stack, Op::kPop, sizeof(int), 0);
+  tracer.record(&stack, Op::kDestroy, sizeof(int), 0);
+  tracer.stop();
+  EXPECT_FALSE(tracer.active());
+
+  std::vector<StackTracer::Record> records = StackTracer::read(path);
+  std::remove(path.c_str());
+
+  const Op ops[] = {Op::kCreate, Op::kPush, Op::kGrow, Op::kPop, Op::kDestroy};
+  const uint32_t args[] = {0, 1, 11, 0, 0};
+  ASSERT_EQ(records.size(), 5);
+  for (size_t i = 0; i < records.size(); ++i) {
+    EXPECT_EQ(records[i].stack_, reinterpret_cast<uintptr_t>(&stack));
+    EXPECT_EQ(records[i].op_, ops[i]);
+    EXPECT_EQ(records[i].arg_, args[i]);
+    EXPECT_EQ(records[i].elem_size_, sizeof(int));
+  }
+}
+
+TEST(StackTracerTest, InactiveTracerDropsRecords) {
+  std::string path = trace_path("inactive");
+  int stack = 0;
+
+  StackTracer& tracer = StackTracer::instance();
+  tracer.record(&stack, Op::kPush, sizeof(int), 1);
+  tracer.start(path);
+  tracer.record(&stack, Op::kPush, sizeof(int), 2);
+  tracer.stop();
+  tracer.record(&stack, Op::kPush, sizeof(int), 3);
+
+  std::vector<StackTracer::Record> records = StackTracer::read(path);
+  std::remove(path.c_str());
+
+  ASSERT_EQ(records.size(), 1);
+  EXPECT_EQ(records[0].arg_, 2);
+}
+
+TEST(StackTracerTest, FullBuffersAreFlushedInOrder) {
+  std::string path = trace_path("full-buffers");
+  const size_t records_cnt = 3 * StackTracer::kBufferSize + 17;
+  int stack = 0;
+
+  StackTracer& tracer = StackTracer::instance();
+  tracer.start(path);
+  for (size_t i = 0; i < records_cnt; ++i) {
+    tracer.record(&stack, Op::kPush, sizeof(int), i);
+  }
+  tracer.stop();
+
+  std::vector<StackTracer::Record> records = StackTracer::read(path);
+  std::remove(path.c_str());
+
+  ASSERT_EQ(records.size(), records_cnt);
+  for (size_t i = 0; i < records_cnt; ++i) {
+    EXPECT_EQ(records[i].arg_, i);
+  }
+}
+
+TEST(StackTracerTest, PerThreadBuffers) {
+  std::string path = trace_path("threads");
+  const size_t threads_cnt = 4;
+  const size_t records_cnt = StackTracer::kBufferSize + 100;
+  int stacks[threads_cnt];
+
+  StackTracer& tracer = StackTracer::instance();
+  tracer.start(path);
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < threads_cnt; ++t) {
+    threads.emplace_back([&, t] {
+      for (size_t i = 0; i < records_cnt; ++i) {
+        tracer.record(&stacks[t], Op::kPush, sizeof(int), i);
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  tracer.stop();
+
+  std::vector<StackTracer::Record> records = StackTracer::read(path);
+  std::remove(path.c_str());
+
+  ASSERT_EQ(records.size(), threads_cnt * records_cnt);
+  size_t next_arg[threads_cnt] = {};
+  for (const StackTracer::Record& record : records) {
+    size_t t = reinterpret_cast<int*>(record.stack_) - stacks;
+    ASSERT_LT(t, threads_cnt);
+    EXPECT_EQ(record.arg_, next_arg[t]++);
+  }
+}
+
+TEST(StackTracerTest, StopWhileRecording) {
+  std::string path = trace_path("stop-while-recording");
+  int stack = 0;
+
+  StackTracer& tracer = StackTracer::instance();
+  std::atomic<bool> done{false};
+  std::thread recorder{[&] {
+    for (size_t i = 0; !done.load(std::memory_order_relaxed); ++i) {
+      tracer.record(&stack, Op::kPush, sizeof(int), i);
+    }
+  }};
+
+  for (size_t round = 0; round < 20; ++round) {
+    tracer.start(path);
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    tracer.stop();
+
+    std::vector<StackTracer::Record> records = StackTracer::read(path);
+    for (size_t i = 1; i < records.size(); ++i) {
+      ASSERT_LT(records[i - 1].arg_, records[i].arg_);
+    }
+  }
+  done.store(true, std::memory_order_relaxed);
+  recorder.join();
+  std::remove(path.c_str());
+}
+
+TEST(StackTracerTest, ReadRejectsForeignFiles) {
+  EXPECT_THROW(StackTracer::read(trace_path("missing")), std::system_error);
+
+  std::string path = trace_path("foreign");
+  std::ofstream{path} << "definitely not a stack trace";
+  EXPECT_THROW(StackTracer::read(path), std::runtime_error);
+  std::remove(path.c_str());
+}
+
+TEST(StackTracerTest, OutlivesThreadLocalsAtExit) {
+  std::string path = trace_path("exit");
+
+  pid_t pid = fork();
+  ASSERT_NE(pid, -1);
+  if (pid == 0) {
+    PersistentStack<int, false> persistent;
+    persistent.push(1);
+
+    int stack = 0;
+    StackTracer& tracer = StackTracer::instance();
+    tracer.start(path);
+    tracer.record(&stack, Op::kPush, sizeof(int), 1);
+    std::exit(0);
+  }
+
+  int status = 0;
+  ASSERT_EQ(waitpid(pid, &status, 0), pid);
+  ASSERT_TRUE(WIFEXITED(status));
+  EXPECT_EQ(WEXITSTATUS(status), 0);
+
+  std::vector<StackTracer::Record> records = StackTracer::read(path);
+  std::remove(path.c_str());
+
+  ASSERT_EQ(records.size(), 1);
+  EXPECT_EQ(records[0].op_, Op::kPush);
+}
+
+#ifdef STACK_TRACE
+TEST(StackTracerTest, StackHooks) {
+  std::string path = trace_path("hooks");
+  const size_t pushes_cnt = 1000;
+
+  StackTracer& tracer = StackTracer::instance();
+  tracer.start(path);
+  uintptr_t address = 0;
+  {
+    Stack<int> stack;
+    address = reinterpret_cast<uintptr_t>(&stack);
+    for (size_t i = 0; i < pushes_cnt; ++i) {
+      stack.push(static_cast<int>(i));
+    }
+    stack.pop();
+  }
+  tracer.stop();
+
+  std::vector<StackTracer::Record> records = StackTracer::read(path);
+  std::remove(path.c_str());
+
+  ASSERT_GE(records.size(), pushes_cnt + 3);
+  EXPECT_EQ(records.front().op_, Op::kCreate);
+  EXPECT_EQ(records[records.size() - 2].op_, Op::kPop);
+  EXPECT_EQ(records[records.size() - 2].arg_, pushes_cnt - 1);
+  EXPECT_EQ(records.back().op_, Op::kDestroy);
+
+  size_t size = 0;
+  size_t capacity = 0;
+  size_t grows_cnt = 0;
+  for (const StackTracer::Record& record : records) {
+    EXPECT_EQ(record.stack_, address);
+    EXPECT_EQ(record.elem_size_, sizeof(int));
+    if (record.op_ == Op::kPush) {
+      EXPECT_EQ(record.arg_, ++size);
+    } else if (record.op_ == Op::kGrow) {
+      EXPECT_GT(record.arg_, capacity);
+      EXPECT_GE(size, capacity);
+      capacity = record.arg_;
+      ++grows_cnt;
+    }
+  }
+  EXPECT_GT(grows_cnt, 0);
+}
+
+TEST(StackTracerTest, MoveIsNotCreation) {
+  std::string path = trace_path("move");
+
+  StackTracer& tracer = StackTracer::instance();
+  tracer.start(path);
+  uintptr_t source = 0;
+  {
+    Stack<int> stack;
+    source = reinterpret_cast<uintptr_t>(&stack);
+    stack.push(1);
+    Stack<int> moved{std::move(stack)};
+  }
+  tracer.stop();
+
+  std::vector<StackTracer::Record> records = StackTracer::read(path);
+  std::remove(path.c_str());
+
+  size_t creates_cnt = 0;
+  size_t moves_cnt = 0;
+  for (const StackTracer::Record& record : records) {
+    if (record.stack_ == source) {
+      creates_cnt += record.op_ == Op::kCreate;
+      moves_cnt += record.op_ == Op::kMovedFrom;
+    }
+  }
+  EXPECT_EQ(creates_cnt, 1);
+  EXPECT_EQ(moves_cnt, 1);
+}
+#endif
@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "stack/ThreadPool.h"
+#include "stack/ThreadPool_impl.h"
+
+TEST(ThreadPoolTest, ParallelForCoversRange) {
+  ThreadPool pool(4);
+  const size_t size = 100003;
+  std::vector<int> hits(size);
+
+  pool.parallel_for(size, 1000, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      ++hits[i];
+    }
+  });
+
+  for (size_t i = 0; i < size; ++i) {
+    ASSERT_EQ(hits[i], 1);
+  }
+}
+
+TEST(ThreadPoolTest, SmallRangeRunsInline) {
+  ThreadPool pool(4);
+  size_t calls = 0;
+
+  pool.parallel_for(10, 1000, [&](size_t begin, size_t end) {
+    ++calls;
+    EXPECT_EQ(begin, 0);
+    EXPECT_EQ(end, 10);
+  });
+
+  EXPECT_EQ(calls, 1);
+}
+
+TEST(ThreadPoolTest, NestedParallelFor) {
+  ThreadPool pool(2);
+  std::atomic<size_t> sum{0};
+
+  pool.parallel_for(8, 1, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      pool.parallel_for(100, 10, [&](size_t inner_begin, size_t inner_end) {
+        sum.fetch_add(inner_end - inner_begin);
+      });
+    }
+  });
+
+  EXPECT_EQ(sum.load(), 800);
+}
+
+TEST(ThreadPoolTest, ChunksStayInRange) {
+  ThreadPool pool(4);
+  const size_t size = 5;
+  std::vector<std::atomic<int>> hits(size);
+
+  pool.parallel_for(size, 1, [&](size_t begin, size_t end) {
+    ASSERT_LT(begin, end);
+    ASSERT_LE(end, size);
+    for (size_t i = begin; i < end; ++i) {
+      ++hits[i];
+    }
+  });
+
+  for (size_t i = 0; i < size; ++i) {
+    EXPECT_EQ(hits[i].load(), 1);
+  }
+}
+
+TEST(ThreadPoolTest, ExceptionOnCallerWaitsForWorkers) {
+  ThreadPool pool(4);
+  std::atomic<size_t> finished{0};
+
+  EXPECT_THROW(pool.parallel_for(4000,
+                                 1000,
+                                 [&](size_t begin, size_t) {
+                                   if (begin == 0) {
+                                     throw std::runtime_error("caller chunk");
+                                   }
+                                   std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                                   finished.fetch_add(1);
+                                 }),
+               std::runtime_error);
+  EXPECT_EQ(finished.load(), 3);
+}
+
+TEST(ThreadPoolTest, ExceptionOnWorkerIsRethrown) {
+  ThreadPool pool(4);
+
+  EXPECT_THROW(pool.parallel_for(4000,
+                                 1000,
+                                 [&](size_t begin, size_t) {
+                                   if (begin != 0) {
+                                     throw std::runtime_error("worker chunk");
+                                   }
+                                 }),
+               std::runtime_error);
+
+  std::atomic<size_t> sum{0};
+  pool.parallel_for(4000, 1000, [&](size_t begin, size_t end) { sum.fetch_add(end - begin); });
+  EXPECT_EQ(sum.load(), 4000);
+}